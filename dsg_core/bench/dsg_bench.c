@@ -0,0 +1,123 @@
+/**
+ * \file        dsg_bench.c
+ * \brief       Host benchmark of the dsg_core modules, against the mock HAL.
+ * \details     Times the table of each signal, its conversion to codes, the output of the samples
+ * and the capture of the keypad. The DAC writes are counted by the mock HAL and the
+ * captured keys are checked, so a change that breaks the modules is seen here too.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_hal.h"
+#include "hal_mock.h"
+#include "dsg_signal.h"
+#include "dsg_dac.h"
+#include "dsg_keypad.h"
+#include "dsg_button.h"
+
+#define BENCH_RUNS  20000   // Tables of SAMPLE values per measurement
+
+static const char *gShape[] = {"sin", "tri", "saw", "sqr"};
+
+/**
+ * @brief Print the time per operation
+ *
+ * @param name
+ * @param t0    Start, in us
+ * @param n     Number of operations
+ */
+static void bench_print(const char *name, uint64_t t0, uint32_t n)
+{
+    uint64_t dt = hal_time_us() - t0;
+    printf("%-14s %8.1f ns/op  (%lu ops, %llu us)\n", name, (double)dt*1000/n,
+        (unsigned long)n, (unsigned long long)dt);
+}
+
+int main(void)
+{
+    signal_t signal;
+    dac_t dac;
+    key_pad_t kpad;
+    gpio_button_t button;
+    int err = 0;
+
+    signal_gen_init(&signal, 10, 1000, 1000, true);
+    dac_init(&dac, &dac_parallel8, 16, NULL, true);
+    kp_init(&kpad, 2, 6, true);
+    button_init(&button, 22, true);
+
+    // Tables of the signals
+    for (uint8_t ss = 0; ss < 4; ss++){
+        char name[16];
+        signal_set_state(&signal, ss);
+        uint64_t t0 = hal_time_us();
+        for (uint32_t i = 0; i < BENCH_RUNS; i++){
+            signal_calculate(&signal);
+        }
+        snprintf(name, sizeof(name), "table %s", gShape[ss]);
+        bench_print(name, t0, BENCH_RUNS);
+    }
+
+    // Conversion of the table to codes, once per change of the signal
+    uint64_t t0 = hal_time_us();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++){
+        dac_codes(&dac, signal.arrayV, signal.arrayC, NULL, SAMPLE);
+    }
+    bench_print("dac table", t0, BENCH_RUNS);
+
+    // Output of the samples
+    uint32_t w0 = hal_mock_writes();
+    t0 = hal_time_us();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++){
+        for (uint8_t k = 0; k < SAMPLE; k++){
+            dac_output_codes(&dac, signal.arrayC[k], 0);
+        }
+    }
+    bench_print("dac sample", t0, BENCH_RUNS*SAMPLE);
+    if(hal_mock_writes() - w0 != (uint32_t)BENCH_RUNS*SAMPLE){
+        printf("dac: %lu writes, expected %lu\n", (unsigned long)(hal_mock_writes() - w0),
+            (unsigned long)BENCH_RUNS*SAMPLE);
+        err = 1;
+    }
+    if(((hal_mock_outputs() >> dac.gpio_lsb) & 0xFF) != signal.arrayC[SAMPLE - 1]){
+        printf("dac: output 0x%02lx, expected 0x%02x\n",
+            (unsigned long)((hal_mock_outputs() >> dac.gpio_lsb) & 0xFF), signal.arrayC[SAMPLE - 1]);
+        err = 1;
+    }
+
+    // Row sequence and capture: the key 8 (second row, third col) is pressed
+    t0 = hal_time_us();
+    uint32_t keys = 0;
+    for (uint32_t i = 0; i < BENCH_RUNS*4; i++){
+        kp_gen_seq(&kpad);
+        uint32_t rows = (hal_mock_outputs() >> kpad.KEY.rlsb) & 0xF;
+        hal_mock_set_inputs((rows & 0x2) ? (0x4u << kpad.KEY.clsb) : 0);
+        uint32_t cols = kp_get_cols(&kpad);
+        if(cols){
+            kp_capture(&kpad, cols);
+            keys++;
+        }
+    }
+    bench_print("keypad scan", t0, BENCH_RUNS*4);
+    if(keys != BENCH_RUNS || kp_get_key(&kpad) != 0x08){
+        printf("keypad: %lu keys, last 0x%02x, expected %lu and 0x08\n",
+            (unsigned long)keys, kpad.history[0], (unsigned long)BENCH_RUNS);
+        err = 1;
+    }
+
+    hal_mock_set_inputs(1u << button.KEY.gpio_num);
+    if(!button_get(&button)){
+        printf("button: not read\n");
+        err = 1;
+    }
+
+    printf("%s\n", err ? "FAIL" : "OK");
+    return err;
+}
@@ -1,21 +1,21 @@
 /**
- * \file        gpio_button.h
- * \brief
- * \details
+ * \file        dsg_button.h
+ * \brief       Single button connected to a GPIO, with a pull-down.
+ * \details     The debouncer and the reading (polling or the rising edge interrupt) are
+ * made by each variant.
  * \author      MST_CDA
  * \version     0.0.1
- * \date        07/04/2024
+ * \date        18/10/2026
  * \copyright   Unlicensed
  */
 
-#ifndef __GPIO_BUTTON_
-#define __GPIO_BUTTON_
+#ifndef __DSG_BUTTON_
+#define __DSG_BUTTON_
 
 #include <stdint.h>
-#include "hardware/timer.h"
-#include "hardware/gpio.h"
+#include <stdbool.h>
 
-#include "functs.h"
+#include "dsg_hal.h"
 
 /**
  * @typedef gpio_button_t 
@@ -26,6 +26,7 @@
 typedef struct{
     struct {
         uint8_t gpio_num    : 6;        // GPIO gpio_num number
+        uint8_t en          : 1;        // Enable button processing
         uint8_t dzero       : 1;        // Flag for double zero
         uint8_t nkey        : 1;        // Flag that indicates that a key was pressed
         uint8_t dbnc        : 1;        // Flag that indicates that debouncer is active
@@ -37,18 +38,49 @@ typedef struct{
  * 
  * @param button 
  * @param gpio_num 
+ * @param en 
  */
-static inline void button_init(gpio_button_t *button, uint8_t gpio_num){
+static inline void button_init(gpio_button_t *button, uint8_t gpio_num, bool en){
+    button->KEY.en = en;
     button->KEY.dzero = 0;
     button->KEY.nkey = 0;
     button->KEY.dbnc = 0;
     button->KEY.gpio_num = gpio_num;
 
-    gpio_init(button->KEY.gpio_num);
-    gpio_set_dir(button->KEY.gpio_num, GPIO_IN);
-    gpio_pull_down(button->KEY.gpio_num);
+    hal_gpio_init_mask(1u << button->KEY.gpio_num);
+    hal_gpio_set_dir_masked(1u << button->KEY.gpio_num, 0);
+    hal_gpio_pull_down_mask(1u << button->KEY.gpio_num);
+}
+
+/**
+ * @brief Read the button from a sample of all the GPIOs
+ * 
+ * @param button 
+ * @param gpios Value of hal_gpio_get_all()
+ * @return true if it is pressed
+ */
+static inline bool button_of(gpio_button_t *button, uint32_t gpios){
+    return (gpios >> button->KEY.gpio_num) & 1u;
+}
+
+/**
+ * @brief Read the button
+ * 
+ * @param button 
+ * @return true if it is pressed
+ */
+static inline bool button_get(gpio_button_t *button){
+    return button_of(button, hal_gpio_get_all());
+}
 
-    gpio_set_irq_enabled_with_callback(button->KEY.gpio_num, GPIO_IRQ_EDGE_RISE, true, gpioCallback);
+/**
+ * @brief Set the callback of the rising edge interrupt of the button and enable it.
+ * 
+ * @param button 
+ * @param cb 
+ */
+static inline void button_set_irq_callback(gpio_button_t *button, hal_gpio_cb_t cb){
+    hal_gpio_irq_set(button->KEY.gpio_num, true, cb);
 }
 
 /**
@@ -58,7 +90,7 @@ static inline void button_init(gpio_button_t *button, uint8_t gpio_num){
  * @param enable true to enable the button interruption, false to disable.
  */
 static inline void button_set_irq_enabled(gpio_button_t *button, bool enable){
-    gpio_set_irq_enabled(button->KEY.gpio_num, GPIO_IRQ_EDGE_RISE, enable);
+    hal_gpio_irq_set(button->KEY.gpio_num, enable, NULL);
 }
 
 /** 
@@ -84,5 +116,4 @@ static inline bool button_is_2nd_zero(gpio_button_t *button){
     return button->KEY.dzero;
 }
 
-
-#endif
\ No newline at end of file
+#endif // __DSG_BUTTON_
@@ -0,0 +1,163 @@
+/**
+ * \file        dsg_dac.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "dsg_hal.h"
+#include "dsg_dac.h"
+#include "requant_ref.h"
+
+static uint32_t dac_xs = 0x2545F491; // State of the dither generator
+
+
+void dac_init(dac_t *dac, const dac_backend_t *backend, uint8_t gpio_lsb, const uint8_t pins_b[8], bool en)
+{
+    dac->backend = backend;
+    dac->gpio_lsb = gpio_lsb;
+    dac->en = en;
+    dac->mask = 0;
+    dac->range = DAC_RANGE;
+    for (uint16_t code = 0; code < 256; code++){
+        dac->lut_b[code] = 0;
+    }
+    dac_cal_nominal(dac);
+    dac->requant = DAC_REQ_NEAREST;
+    dac->corr_gain = DAC_CORR_ONE;
+    dac->corr_offset = 0;
+    dac->sync_gpio = 0;
+    dac->sync_mask = 0;
+
+    backend->init(dac, pins_b);
+}
+
+bool dac_set_sync(dac_t *dac, uint8_t gpio, bool en)
+{
+    if(!dac->backend->sync)
+        return false;
+
+    dac->mask &= ~dac->sync_mask;
+    if(dac->sync_mask)
+        hal_gpio_put_masked(dac->sync_mask, 0);
+    dac->sync_mask = 0;
+    if(en){
+        assert(!(dac->mask & (1UL << gpio))); // Not a GPIO of the buses
+        hal_gpio_init_mask(1UL << gpio);
+        hal_gpio_set_dir_masked(1UL << gpio, 1UL << gpio);
+        hal_gpio_put_masked(1UL << gpio, 0);
+        dac->sync_gpio = gpio;
+        dac->sync_mask = 1UL << gpio;
+        dac->mask |= dac->sync_mask;
+    }
+    return true;
+}
+
+void dac_cal_nominal(dac_t *dac)
+{
+    for (int32_t code = 0; code <= RESOLUTION; code++){
+        dac->cal[code] = (int16_t)(((2*code + 1)*dac->range)/(2*RESOLUTION) - 5000 - DAC_BIAS);
+    }
+}
+
+void dac_set_range(dac_t *dac, uint16_t range)
+{
+    dac->range = range;
+    dac_cal_nominal(dac);
+}
+
+/**
+ * @brief Code of a value in 1/scale LSB, for dac_code() and dac_code_q()
+ */
+static uint32_t dac_code_scaled(const dac_t *dac, int16_t decim_v, uint32_t scale)
+{
+    // Correction of the closed loop, around 0 mV as the drift of the output stage
+    int32_t v = (int32_t)(((int64_t)decim_v*dac->corr_gain + DAC_CORR_ONE/2) >> 16) + dac->corr_offset;
+    decim_v = (int16_t)(v < INT16_MIN ? INT16_MIN : v > INT16_MAX ? INT16_MAX : v);
+
+    // First entry whose output is not lower than decim_v
+    uint16_t lo = 0, hi = RESOLUTION;
+    while(lo < hi){
+        uint16_t mid = (lo + hi)/2;
+        if(dac->cal[mid] < decim_v)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if(lo == 0)
+        return 0;
+    if(dac->cal[lo] < decim_v)
+        return (uint32_t)dac_code_max(dac)*scale;
+
+    // decim_v is between the entries lo - 1 and lo, in 1/255 of the full scale
+    int64_t d = dac->cal[lo] - dac->cal[lo - 1];
+    int64_t num = ((lo - 1)*d + (decim_v - dac->cal[lo - 1]))*dac_code_max(dac)*scale;
+    int64_t den = d*RESOLUTION;
+    return (uint32_t)((num + den/2)/den);
+}
+
+uint16_t dac_code(const dac_t *dac, int16_t decim_v)
+{
+    return (uint16_t)dac_code_scaled(dac, decim_v, 1);
+}
+
+uint32_t dac_code_q(const dac_t *dac, int16_t decim_v)
+{
+    return dac_code_scaled(dac, decim_v, RQ_ONE);
+}
+
+int16_t dac_mv(const dac_t *dac, uint16_t code)
+{
+    uint32_t max = dac_code_max(dac);
+    uint32_t q = (uint32_t)code*RESOLUTION;
+    uint32_t i = q/max;
+    if(i >= RESOLUTION)
+        return dac->cal[RESOLUTION];
+    return (int16_t)(dac->cal[i] + (int32_t)(dac->cal[i + 1] - dac->cal[i])*(int32_t)(q%max)/(int32_t)max);
+}
+
+void dac_codes(const dac_t *dac, const int16_t *decim_v, uint16_t *codes, uint32_t *q, uint16_t n)
+{
+    uint16_t max = dac_code_max(dac);
+    int32_t err = 0;
+
+    switch(dac->requant){
+        case DAC_REQ_TPDF:
+            for (uint16_t i = 0; i < n; i++){
+                uint32_t qi = dac_code_q(dac, decim_v[i]);
+                if(q)
+                    q[i] = qi;
+                codes[i] = rq_ref_tpdf(qi, max, &dac_xs);
+            }
+            break;
+        case DAC_REQ_SHAPE:
+            // The first pass only sets the error of the last value, for the first one.
+            // The error is in fractions of the code, so the correction and the calibration are in it
+            for (uint8_t pass = 0; pass < 2; pass++){
+                for (uint16_t i = 0; i < n; i++){
+                    codes[i] = rq_ref_shape(dac_code_q(dac, decim_v[i]), max, &err);
+                }
+            }
+            break;
+        default:
+            for (uint16_t i = 0; i < n; i++){
+                codes[i] = dac_code(dac, decim_v[i]);
+            }
+            break;
+    }
+}
+
+void dac_redither(const dac_t *dac, const uint32_t *q, uint16_t *codes, uint16_t n)
+{
+    uint16_t max = dac_code_max(dac);
+    for (uint16_t i = 0; i < n; i++){
+        codes[i] = (codes[i] & DAC_MARK) | rq_ref_tpdf(q[i], max, &dac_xs);
+    }
+}
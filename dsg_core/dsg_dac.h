@@ -0,0 +1,256 @@
+/**
+ * \file        dsg_dac.h
+ * \brief       DAC of the variants: conversion of the values in mV to codes and their output.
+ * \details     The tables of the signals are converted to codes of the DAC backend 
+ * selected in dac_init(): its bit depth sets the quantization and its max rate 
+ * limits the sample rate. The conversion goes through a calibration table, the nominal 
+ * transfer of the output stage (dac_set_range()) or the one measured on the board (irq_c), 
+ * and the tables can be requantized (requant_ref.h). Backends:
+ *      dac_parallel8:  DAC0808, 8 bits on GPIOs. Two channels (see dsg_dac_parallel.c)
+ *      dac_parallel12: R-2R ladder, 12 bits on GPIOs. One channel
+ *      dac_mcp4922:    MCP4922, 12 bits by SPI. Two channels (irq_c/dac_spi.c)
+ *      dac_pwm:        PWM of one GPIO and an RC filter, 8 bits. One channel (irq_c/dac_pwm.c)
+ * The parallel backends only reach the GPIOs through dsg_hal.h, the others and the DMA
+ * are in irq_c (dac.h).
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_DAC_
+#define __DSG_DAC_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_hal.h"
+
+#define RESOLUTION  255         // 8 bits, entries of the calibration table - 1
+#define DAC_RANGE   10120       // Default range in mV of the output stage, nominal transfer used when the board is not calibrated
+#define DAC_BIAS    -60         // DAC bias, nominal transfer used when the board is not calibrated
+
+#define DAC_REQ_NEAREST 0       // Requantization of the tables: nearest code
+#define DAC_REQ_TPDF    1       // Requantization of the tables: TPDF dither of +-1 LSB
+#define DAC_REQ_SHAPE   2       // Requantization of the tables: first order error feedback (noise shaping)
+#define DAC_CORR_ONE    65536   // Gain correction of 1 (Q16)
+#define DAC_MARK        0x8000  // Bit of a code of the channel A that raises the sync output (see dac_set_sync())
+
+typedef struct dac_backend dac_backend_t;
+
+/**
+ * @typedef dac_t 
+ *
+ * @brief Structure to manage a DAC
+ * 
+ */
+typedef struct{
+    bool en;                        ///< Enable DAC
+    uint8_t gpio_lsb;                ///< The LSB position of the GPIOs used to output the DAC signal
+    uint32_t mask;                  ///< GPIOs of all the channels, written at the same time
+    uint32_t lut_b[256];            ///< GPIO values of each code of the second bus, its pins are not consecutive
+    int16_t cal[RESOLUTION + 1];    ///< Output in mV at each 1/255 of the full scale, it must be increasing (see irq_c/dac_cal.h)
+    uint16_t range;                 ///< Range in mV of the output stage of the nominal transfer, DAC_RANGE by default
+    uint8_t requant;                ///< Requantization of the tables: DAC_REQ_NEAREST, DAC_REQ_TPDF or DAC_REQ_SHAPE
+    int32_t corr_gain;              ///< Gain correction of the closed loop (dac_loop.h), Q16
+    int16_t corr_offset;            ///< Offset correction of the closed loop, in mV
+    uint8_t sync_gpio;              ///< GPIO of the sync output
+    uint32_t sync_mask;             ///< GPIO of the sync output, in mask. 0 if it is disabled
+    const dac_backend_t *backend;   ///< Hardware that outputs the codes
+}dac_t;
+
+/**
+ * @typedef dac_backend_t
+ *
+ * @brief Operations of a DAC backend
+ *
+ */
+struct dac_backend{
+    const char *name;
+    uint8_t bits;                   ///< Bit depth of the codes
+    uint8_t channels;               ///< 1: the code of the channel B is ignored, 2
+    bool sync;                      ///< write() outputs DAC_MARK of code_a on the sync GPIO, with the code
+    uint8_t block_channels;         ///< Channels output by write_block(), 0 without it. The DMA can only replace the signal ISR if they are all the channels
+    /**
+     * @brief Configure the hardware. pins_b are the GPIOs of the second bus, if it has one.
+     */
+    void (*init)(dac_t *dac, const uint8_t pins_b[8]);
+    /**
+     * @brief Output the codes of both channels at the same time. Called from the signal ISR.
+     */
+    void (*write)(dac_t *dac, uint16_t code_a, uint16_t code_b);
+    /**
+     * @brief Output a block of codes by DMA at rate Hz, without the CPU. The channel B, if the
+     * backend outputs it, starts at codes_b[start_b] and wraps, so it keeps its phase.
+     * With loop, the block is output again and again until stop_block(), and the codes must 
+     * not be freed before. NULL if the backend can only be written by the CPU.
+     * @return false if the rate or the size of the block are not supported
+     */
+    bool (*write_block)(dac_t *dac, const uint16_t *codes_a, const uint16_t *codes_b, uint16_t start_b,
+                        uint16_t n, uint32_t rate, bool loop);
+    /**
+     * @brief Stop the output of write_block(). NULL if the backend does not have write_block().
+     */
+    void (*stop_block)(dac_t *dac);
+    /**
+     * @brief Max sample rate in Hz that the backend can sustain.
+     */
+    uint32_t (*max_rate)(const dac_t *dac);
+    /**
+     * @brief Recompute the dividers of clk_sys or clk_peri after a change of clock profile.
+     * NULL if the backend does not need it.
+     */
+    void (*clk_update)(dac_t *dac);
+};
+
+extern const dac_backend_t dac_parallel8;
+extern const dac_backend_t dac_parallel12;
+
+/**
+ * @brief Initialize the DAC with a backend. The calibration table is set to the nominal transfer.
+ * 
+ * @param dac 
+ * @param backend   dac_parallel8, dac_parallel12, or the ones of irq_c: dac_mcp4922 and dac_pwm
+ * @param gpio_lsb  The LSB position of the GPIOs of the parallel bus
+ * @param pins_b    GPIOs of the second bus of the parallel backends, from the LSB to the MSB:
+ *                  channel B of dac_parallel8, the 4 LSBs of dac_parallel12. There are not 8 consecutive 
+ *                  free GPIOs beside the channel A, so each bit has its own GPIO and the code is translated 
+ *                  with a table (lut_b) to the value of the GPIOs. NULL for dac_parallel8 without the 
+ *                  channel B (polling variants).
+ * @param en        Enable DAC
+ */
+void dac_init(dac_t *dac, const dac_backend_t *backend, uint8_t gpio_lsb, const uint8_t pins_b[8], bool en);
+
+/**
+ * @brief Max code of the backend
+ * 
+ * @param dac 
+ * @return uint16_t 
+ */
+static inline uint16_t dac_code_max(const dac_t *dac)
+{
+    return (uint16_t)((1UL << dac->backend->bits) - 1);
+}
+
+/**
+ * @brief Convert a value in mV to a code of the DAC: the nearest one, interpolating
+ * the calibration table. It is a binary search, so it is used when the tables are 
+ * built, not in the signal ISR. The value is corrected before: decim_v*corr_gain + corr_offset.
+ * 
+ * @param dac 
+ * @param decim_v Value in mV
+ * @return uint16_t 
+ */
+uint16_t dac_code(const dac_t *dac, int16_t decim_v);
+
+/**
+ * @brief Same as dac_code(), without the rounding: the code in 1/RQ_ONE LSB, for the
+ * requantization of requant_ref.h.
+ * 
+ * @param dac 
+ * @param decim_v Value in mV
+ * @return uint32_t 
+ */
+uint32_t dac_code_q(const dac_t *dac, int16_t decim_v);
+
+/**
+ * @brief Output in mV of a code, interpolating the calibration table. The correction
+ * of the closed loop is not undone.
+ * 
+ * @param dac 
+ * @param code 
+ * @return int16_t 
+ */
+int16_t dac_mv(const dac_t *dac, uint16_t code);
+
+/**
+ * @brief Convert one period of a signal in mV to DAC codes, with the requantization
+ * selected in dac->requant:
+ *  - DAC_REQ_NEAREST: nearest code of each value.
+ *  - DAC_REQ_TPDF: triangular dither of +-1 LSB is added before, the error is not 
+ *    correlated with the signal, so there are no harmonics, only a noise floor. The 
+ *    table is played for many periods, so the dither must be drawn again with 
+ *    dac_redither(), or its error repeats every period and lands on the harmonics.
+ *  - DAC_REQ_SHAPE: the error of each code is added to the next value (1 - z^-1), 
+ *    the error is moved to the high frequencies, where the table rate is much higher 
+ *    than the signal frequency. The values are taken as periodic: the error of the 
+ *    last one is carried to the first one.
+ * 
+ * @param dac 
+ * @param decim_v Values in mV
+ * @param codes 
+ * @param q Codes without the dither (dac_code_q()) for dac_redither(), only in DAC_REQ_TPDF. 
+ * NULL if they are not needed
+ * @param n Number of values
+ */
+void dac_codes(const dac_t *dac, const int16_t *decim_v, uint16_t *codes, uint32_t *q, uint16_t n);
+
+/**
+ * @brief Draw a new TPDF dither for a table built by dac_codes(). It runs from the main
+ * loop while the table is output: each code is a single write, and DAC_MARK is kept.
+ * 
+ * @param dac 
+ * @param q Codes without the dither, from dac_codes()
+ * @param codes 
+ * @param n Number of codes
+ */
+void dac_redither(const dac_t *dac, const uint32_t *q, uint16_t *codes, uint16_t n);
+
+/**
+ * @brief Set the correction of the closed loop. The tables must be built again.
+ * 
+ * @param dac 
+ * @param gain      Q16, DAC_CORR_ONE for none
+ * @param offset    in mV
+ */
+static inline void dac_set_correction(dac_t *dac, int32_t gain, int16_t offset)
+{
+    dac->corr_gain = gain;
+    dac->corr_offset = offset;
+}
+
+/**
+ * @brief Fill the calibration table with the nominal transfer: range and DAC_BIAS.
+ * Each entry is the center of the interval of values that had that code.
+ * 
+ * @param dac 
+ */
+void dac_cal_nominal(dac_t *dac);
+
+/**
+ * @brief Set the range of the output stage, it depends on the board. The calibration
+ * table is set to the nominal transfer with it, the tables must be built again.
+ * 
+ * @param dac 
+ * @param range in mV
+ */
+void dac_set_range(dac_t *dac, uint16_t range);
+
+/**
+ * @brief Enable or disable the sync output. The codes of the channel A that have DAC_MARK 
+ * raise the GPIO in the same write as the code, so the pulse has no jitter with the samples. 
+ * DAC_MARK must only be added to the codes while it is enabled.
+ * 
+ * @param dac 
+ * @param gpio  Not used by the buses of the DAC
+ * @param en 
+ * @return false if the backend can not output it
+ */
+bool dac_set_sync(dac_t *dac, uint8_t gpio, bool en);
+
+/**
+ * @brief Output the codes of both channels, so they change at the same time.
+ * 
+ * @param dac 
+ * @param code_a 
+ * @param code_b 
+ */
+static inline void dac_output_codes(dac_t *dac, uint16_t code_a, uint16_t code_b)
+{
+    if(!dac->en) return;
+
+    dac->backend->write(dac, code_a, code_b);
+}
+
+#endif // __DSG_DAC_
+
@@ -0,0 +1,71 @@
+/**
+ * \file        dsg_dac_cal.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_dac_cal.h"
+
+void dac_cal_init(dac_cal_t *cal)
+{
+    cal->n = 0;
+    cal->cur = -1;
+}
+
+bool dac_cal_add(dac_cal_t *cal, uint16_t code, int16_t mv)
+{
+    uint8_t i = 0;
+    while(i < cal->n && cal->code[i] < code) i++;
+
+    if(i < cal->n && cal->code[i] == code){
+        cal->mv[i] = mv;
+        return true;
+    }
+    if(cal->n >= DAC_CAL_POINTS)
+        return false;
+
+    // Keep the points sorted by code
+    for (uint8_t j = cal->n; j > i; j--){
+        cal->code[j] = cal->code[j - 1];
+        cal->mv[j] = cal->mv[j - 1];
+    }
+    cal->code[i] = code;
+    cal->mv[i] = mv;
+    cal->n++;
+    return true;
+}
+
+bool dac_cal_fit(const dac_cal_t *cal, dac_t *dac)
+{
+    if(cal->n < 2)
+        return false;
+    for (uint8_t i = 1; i < cal->n; i++){
+        if(cal->mv[i] <= cal->mv[i - 1])
+            return false;
+    }
+
+    // The entry i of the table is at the code i*max/RESOLUTION, the positions are compared in 1/RESOLUTION of a code
+    int64_t max = dac_code_max(dac);
+    uint8_t seg = 0; // Segment between the points seg and seg + 1
+    for (int32_t i = 0; i <= RESOLUTION; i++){
+        int64_t x = i*max;
+        while(seg < cal->n - 2 && x > (int64_t)cal->code[seg + 1]*RESOLUTION) seg++;
+
+        int64_t x0 = (int64_t)cal->code[seg]*RESOLUTION, x1 = (int64_t)cal->code[seg + 1]*RESOLUTION;
+        int64_t v0 = cal->mv[seg], v1 = cal->mv[seg + 1];
+        int64_t num = (v1 - v0)*(x - x0);
+        int64_t den = x1 - x0;
+        // Rounded to the nearest mV, also for the negative values of the extrapolation
+        int64_t v = v0 + (num >= 0 ? (num + den/2)/den : (num - den/2)/den);
+        dac->cal[i] = (int16_t)(v < INT16_MIN ? INT16_MIN : v > INT16_MAX ? INT16_MAX : v);
+    }
+    return true;
+}
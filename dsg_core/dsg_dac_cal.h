@@ -0,0 +1,66 @@
+/**
+ * \file        dsg_dac_cal.h
+ * \brief       Calibration table of the DAC from measured points.
+ * \details     The output of a few codes is measured and the table of the DAC (dac_t.cal,
+ * the output at each 1/255 of the full scale) is interpolated between them. Between the
+ * measured points the table is interpolated linearly, at least two points are needed. The
+ * table is inverted (dac_code()) when the signal tables are built, so the sample path only
+ * reads codes. irq_c stores the table in the flash (irq_c/dac_cal.h), dsg_render fits the
+ * same table from a file of points.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_DAC_CAL_
+#define __DSG_DAC_CAL_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_dac.h"
+
+#define DAC_CAL_POINTS  16      // Max number of measured points
+
+/**
+ * @typedef dac_cal_t
+ *
+ * @brief Structure to store the measured points of the calibration
+ *
+ */
+typedef struct{
+    uint8_t n;                          // Number of measured points
+    uint16_t code[DAC_CAL_POINTS];      // Codes measured, increasing
+    int16_t mv[DAC_CAL_POINTS];         // Output in mV of each code
+    int32_t cur;                        // Code being output, -1 if the generator is running
+}dac_cal_t;
+
+/**
+ * @brief Initialize the calibration procedure, without measured points
+ *
+ * @param cal
+ */
+void dac_cal_init(dac_cal_t *cal);
+
+/**
+ * @brief Add a measured point. If the code was already measured, its value is replaced.
+ *
+ * @param cal
+ * @param code
+ * @param mv Measured output in mV
+ * @return false if there is not room for more points
+ */
+bool dac_cal_add(dac_cal_t *cal, uint16_t code, int16_t mv);
+
+/**
+ * @brief Fill the table of the DAC by linear interpolation of the measured points.
+ * The ends are extrapolated with the first and the last segment.
+ *
+ * @param cal
+ * @param dac
+ * @return false if there are less than two points or the output does not increase with the code
+ */
+bool dac_cal_fit(const dac_cal_t *cal, dac_t *dac);
+
+#endif // __DSG_DAC_CAL_
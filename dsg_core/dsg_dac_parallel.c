@@ -0,0 +1,111 @@
+/**
+ * \file        dsg_dac_parallel.c
+ * \brief       Backends of the DACs connected to the GPIOs.
+ * \details     dac_parallel8: DAC0808, channel A on 8 consecutive GPIOs from gpio_lsb, 
+ * channel B on the GPIOs of pins_b.
+ * dac_parallel12: R-2R ladder of 12 bits, the 8 MSBs on the GPIOs of the channel A 
+ * (the DAC0808 wiring) and the 4 LSBs on the first 4 GPIOs of pins_b.
+ *
+ * All the bits are written with a single masked store, so there are no glitches 
+ * between bits. The sync output (DAC_MARK) is in the same store. The SIO can not be written by DMA, so they do not have write_block.
+ * Without pins_b (polling variants) dac_parallel8 only has the channel A.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "dsg_hal.h"
+#include "dsg_dac.h"
+
+#define DAC_PARALLEL_RATE   1000000     // Limited by the signal ISR, t_sample is in us
+
+/**
+ * @brief Fill lut_b with the GPIO values of each code of the second bus.
+ * 
+ * @param dac 
+ * @param pins_b GPIOs of the bus, from the LSB
+ * @param bits Number of GPIOs used
+ */
+static void dac_parallel_init_b(dac_t *dac, const uint8_t pins_b[8], uint8_t bits)
+{
+    uint32_t mask_b = 0;
+    for (uint8_t i = 0; i < bits; i++){
+        mask_b |= 1UL << pins_b[i];
+    }
+    assert(!(mask_b & dac->mask)); // The buses must not share GPIOs
+
+    for (uint16_t code = 0; code < (1u << bits); code++){
+        dac->lut_b[code] = 0;
+        for (uint8_t i = 0; i < bits; i++){
+            if(code & (1 << i))
+                dac->lut_b[code] |= 1UL << pins_b[i];
+        }
+    }
+    dac->mask |= mask_b;
+
+    hal_gpio_init_mask(mask_b);
+    hal_gpio_set_dir_masked(mask_b, mask_b); // Set all gpios as outputs
+}
+
+static void dac_parallel_init(dac_t *dac, const uint8_t pins_b[8])
+{
+    dac->mask = 0x000000FF << dac->gpio_lsb;
+    hal_gpio_init_mask(dac->mask);
+    hal_gpio_set_dir_masked(dac->mask, dac->mask); // Set all gpios as outputs
+
+    // Second bus: the channel B or the bits below the 8 MSBs
+    assert(pins_b || dac->backend->bits == 8);
+    if(pins_b)
+        dac_parallel_init_b(dac, pins_b, dac->backend->bits > 8 ? dac->backend->bits - 8 : 8);
+}
+
+static void dac_parallel8_write(dac_t *dac, uint16_t code_a, uint16_t code_b)
+{
+    hal_gpio_put_masked(dac->mask, ((uint32_t)(code_a & 0xFF) << dac->gpio_lsb) | dac->lut_b[code_b]
+                    | ((uint32_t)(code_a >> 15) << dac->sync_gpio));
+}
+
+static void dac_parallel12_write(dac_t *dac, uint16_t code_a, uint16_t code_b)
+{
+    hal_gpio_put_masked(dac->mask, ((uint32_t)((code_a & 0x0FFF) >> 4) << dac->gpio_lsb) | dac->lut_b[code_a & 0x0F]
+                    | ((uint32_t)(code_a >> 15) << dac->sync_gpio));
+}
+
+static uint32_t dac_parallel_max_rate(const dac_t *dac)
+{
+    return DAC_PARALLEL_RATE;
+}
+
+const dac_backend_t dac_parallel8 = {
+    .name = "DAC0808",
+    .bits = 8,
+    .channels = 2,
+    .sync = true,
+    .block_channels = 0,
+    .init = dac_parallel_init,
+    .write = dac_parallel8_write,
+    .write_block = NULL,
+    .stop_block = NULL,
+    .max_rate = dac_parallel_max_rate,
+    .clk_update = NULL,
+};
+
+const dac_backend_t dac_parallel12 = {
+    .name = "R-2R 12 bits",
+    .bits = 12,
+    .channels = 1,
+    .sync = true,
+    .block_channels = 0,
+    .init = dac_parallel_init,
+    .write = dac_parallel12_write,
+    .write_block = NULL,
+    .stop_block = NULL,
+    .max_rate = dac_parallel_max_rate,
+    .clk_update = NULL,
+};
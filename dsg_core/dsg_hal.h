@@ -0,0 +1,119 @@
+/**
+ * \file        dsg_hal.h
+ * \brief       Hardware abstraction of the modules shared by the variants.
+ * \details     The modules of dsg_core only reach the hardware through these functions:
+ * GPIO masks, the microsecond timer, the sleep and the registration of interrupts. hal_pico.c
+ * implements them with the Pico SDK, hal_mock.c in memory for the host build, where the
+ * same modules are benchmarked.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_HAL_
+#define __DSG_HAL_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Callback of a GPIO interrupt, same signature as the one of the Pico SDK
+ *
+ */
+typedef void (*hal_gpio_cb_t)(unsigned int gpio, uint32_t events);
+
+/**
+ * @brief Callback of an interrupt handler
+ *
+ */
+typedef void (*hal_irq_handler_t)(void);
+
+// ------------------------------------------------------------------
+// ------------------------------ GPIO ------------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Initialize the GPIOs of a mask as SIO inputs
+ *
+ * @param mask
+ */
+void hal_gpio_init_mask(uint32_t mask);
+
+/**
+ * @brief Set the direction of the GPIOs of a mask
+ *
+ * @param mask
+ * @param out   1 for the outputs
+ */
+void hal_gpio_set_dir_masked(uint32_t mask, uint32_t out);
+
+/**
+ * @brief Enable the pull-down of the GPIOs of a mask
+ *
+ * @param mask
+ */
+void hal_gpio_pull_down_mask(uint32_t mask);
+
+/**
+ * @brief Write the GPIOs of a mask at the same time
+ *
+ * @param mask
+ * @param value
+ */
+void hal_gpio_put_masked(uint32_t mask, uint32_t value);
+
+/**
+ * @brief Read all the GPIOs
+ *
+ * @return uint32_t
+ */
+uint32_t hal_gpio_get_all(void);
+
+/**
+ * @brief Enable or disable the rising edge interrupt of a GPIO.
+ * All the GPIOs share the same callback.
+ *
+ * @param gpio
+ * @param en
+ * @param cb    NULL to keep the callback
+ */
+void hal_gpio_irq_set(uint8_t gpio, bool en, hal_gpio_cb_t cb);
+
+// ------------------------------------------------------------------
+// ------------------------- Timer and IRQ --------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Microseconds since the boot
+ *
+ * @return uint64_t
+ */
+uint64_t hal_time_us(void);
+
+/**
+ * @brief Sleep until a time of hal_time_us(). Any interrupt or event can wake the core
+ * up before.
+ *
+ * @param us
+ */
+void hal_sleep_until(uint64_t us);
+
+/**
+ * @brief Set the handler of an interrupt and enable it
+ *
+ * @param irq       Number of the interrupt
+ * @param handler
+ * @param priority  0 is the highest
+ */
+void hal_irq_set_handler(uint8_t irq, hal_irq_handler_t handler, uint8_t priority);
+
+/**
+ * @brief Enable or disable an interrupt
+ *
+ * @param irq
+ * @param en
+ */
+void hal_irq_set_enabled(uint8_t irq, bool en);
+
+#endif // __DSG_HAL_
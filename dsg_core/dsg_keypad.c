@@ -1,20 +1,20 @@
 /**
- * \file        keypad_polling.c
+ * \file        dsg_keypad.c
  * \brief
  * \details
- * \author      Ricardo Andres Velásquez
+ * \author      MST_CDA
  * \version     0.0.1
- * \date        05/10/2023
+ * \date        18/10/2026
  * \copyright   Unlicensed
  */
 #include <stdlib.h>
+#include <assert.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include "keypad_polling.h"
-#include "time_base.h"
-#include "hardware/gpio.h"
+#include "dsg_hal.h"
+#include "dsg_keypad.h"
 
-void kp_init(key_pad_t *kpad, uint8_t rlsb, uint8_t clsb, uint64_t dbnc_time, bool en){
+void kp_init(key_pad_t *kpad, uint8_t rlsb, uint8_t clsb, bool en){
     // Initialize history buffer
     for(int i=0; i<10;i++){
         kpad->history[i] = 0xFF;
@@ -30,21 +30,14 @@ void kp_init(key_pad_t *kpad, uint8_t rlsb, uint8_t clsb, uint64_t dbnc_time, bo
     kpad->KEY.nkey = 0;
     kpad->KEY.dbnc = 0;
     kpad->KEY.dzero = 0;
-    if(en)
-        kpad->KEY.en = 1;
-    // Initialize keypad time bases
-    tb_init(&kpad->tb_seq,2000,en);
-    tb_init(&kpad->tb_dbnce,100000,false);
+    kpad->KEY.en = en;
 
     // Initialize keypad gpios
-    gpio_init_mask(0x0000000F << kpad->KEY.rlsb); // gpios for key rows 2,3,4,5
-    gpio_init_mask(0x0000000F << kpad->KEY.clsb); // gpios for key cols 6,7,8,9
-    gpio_set_dir_masked(0x0000000F << kpad->KEY.rlsb,0x0000000F << kpad->KEY.rlsb); // rows as outputs and cols as inputs
-    gpio_set_dir_masked(0x0000000F << kpad->KEY.clsb,0x00000000); // rows as outputs and cols as inputs
-    gpio_pull_down(kpad->KEY.clsb);
-    gpio_pull_down(kpad->KEY.clsb + 1);
-    gpio_pull_down(kpad->KEY.clsb + 2);
-    gpio_pull_down(kpad->KEY.clsb + 3);
+    hal_gpio_init_mask(0x0000000Fu << kpad->KEY.rlsb); // gpios for key rows 2,3,4,5
+    hal_gpio_init_mask(0x0000000Fu << kpad->KEY.clsb); // gpios for key cols 6,7,8,9
+    hal_gpio_set_dir_masked(0x0000000Fu << kpad->KEY.rlsb,0x0000000Fu << kpad->KEY.rlsb); // rows as outputs and cols as inputs
+    hal_gpio_set_dir_masked(0x0000000Fu << kpad->KEY.clsb,0x00000000); // rows as outputs and cols as inputs
+    hal_gpio_pull_down_mask(0x0000000Fu << kpad->KEY.clsb);
 }
 
 void kp_decode(key_pad_t *kpad){
@@ -103,6 +96,9 @@ void kp_decode(key_pad_t *kpad){
 }
 
 void kp_capture(key_pad_t *kpad, uint32_t cols){
+
+    if (!kpad->KEY.en) return;
+
     kpad->KEY.ckey = (cols >> 2) | kpad->KEY.seq;
     kp_decode(kpad);
     for(int i=0;i<9;i++){
@@ -110,4 +106,4 @@ void kp_capture(key_pad_t *kpad, uint32_t cols){
     }
     kpad->history[0] = kpad->KEY.dkey;
     kpad->KEY.nkey = 1;
-}
\ No newline at end of file
+}
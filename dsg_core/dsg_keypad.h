@@ -1,18 +1,22 @@
 /**
- * \file        keypad_irq.h
- * \brief
- * \details
+ * \file        dsg_keypad.h
+ * \brief       4x4 matrix keypad: row sequence, capture and decoding of the keys.
+ * \details     The rows are outputs driven with a sequence of one row high, the columns
+ * are inputs with pull-down. The timing (period of the sequence, debouncer) and the
+ * reading of the columns (polling or interrupts) are made by each variant.
  * \author      MST_CDA
  * \version     0.0.1
- * \date        05/10/2023
+ * \date        18/10/2026
  * \copyright   Unlicensed
  */
 
-#ifndef __KEYPAD_POLLING_IRQ_
-#define __KEYPAD_POLLING_IRQ_
+#ifndef __DSG_KEYPAD_
+#define __DSG_KEYPAD_
 
 #include <stdint.h>
-#include "hardware/gpio.h"
+#include <stdbool.h>
+
+#include "dsg_hal.h"
 
 /**
  * \typedef key_pad_t
@@ -39,7 +43,6 @@ typedef struct{
  * \param kpad          pointer to keypad data structure
  * \param rlsb          LSB position of the first row GPIO
  * \param clsb          LSB position of the first col GPIO
- * \param dbnc_time     Time base period for keypad debouncer
  * \param en            True if keypad start enabled
  */ 
 void kp_init(key_pad_t *kpad, uint8_t rlsb, uint8_t clsb, bool en);
@@ -66,7 +69,17 @@ void kp_capture(key_pad_t *kpad, uint32_t cols);
 static inline void kp_gen_seq(key_pad_t *kpad){
     kpad->KEY.cnt += 1;
     kpad->KEY.seq = 1 << kpad->KEY.cnt;
-    gpio_put_masked(0x0000000F<<kpad->KEY.rlsb,((uint32_t)kpad->KEY.seq)<<kpad->KEY.rlsb);
+    hal_gpio_put_masked(0x0000000F<<kpad->KEY.rlsb,((uint32_t)kpad->KEY.seq)<<kpad->KEY.rlsb);
+}
+
+/**
+ * @brief This method drives the rows with a fixed value, out of the sequence.
+ * 
+ * @param kpad 
+ * @param rows One bit per row
+ */
+static inline void kp_set_rows(key_pad_t *kpad, uint8_t rows){
+    hal_gpio_put_masked(0x0000000F<<kpad->KEY.rlsb,((uint32_t)rows)<<kpad->KEY.rlsb);
 }
 
 /**
@@ -77,10 +90,44 @@ static inline void kp_gen_seq(key_pad_t *kpad){
  */
 static inline void kp_set_irq_enabled(key_pad_t *kpad, bool en){
     for (int i = 0; i < 4; i++){
-        gpio_set_irq_enabled(kpad->KEY.clsb + i, GPIO_IRQ_EDGE_RISE, en);
+        hal_gpio_irq_set(kpad->KEY.clsb + i, en, NULL);
     }
 }
 
+/**
+ * @brief This method sets the callback of the rising edge interrupts of the columns and enables them.
+ * 
+ * @param kpad 
+ * @param cb 
+ */
+static inline void kp_set_irq_callback(key_pad_t *kpad, hal_gpio_cb_t cb){
+    for (int i = 0; i < 4; i++){
+        hal_gpio_irq_set(kpad->KEY.clsb + i, true, cb);
+    }
+}
+
+/**
+ * @brief This method returns the columns of the keypad from a sample of all the GPIOs,
+ * in their GPIO positions.
+ * 
+ * @param kpad 
+ * @param gpios Value of hal_gpio_get_all()
+ * @return uint32_t 
+ */
+static inline uint32_t kp_cols_of(key_pad_t *kpad, uint32_t gpios){
+    return gpios & (0x0000000Fu << kpad->KEY.clsb);
+}
+
+/**
+ * @brief This method returns the columns of the keypad, in their GPIO positions.
+ * 
+ * @param kpad 
+ * @return uint32_t 
+ */
+static inline uint32_t kp_get_cols(key_pad_t *kpad){
+    return kp_cols_of(kpad, hal_gpio_get_all());
+}
+
 /** 
  * \brief This method returns the value of the last pressed key in decimal coding
  * \param kpad   Pointer to keypad data structure
@@ -129,4 +176,4 @@ static inline bool kp_is_2nd_zero(key_pad_t *kpad){
     return kpad->KEY.dzero;
 }
 
-#endif // __KEYPAD_POLLING_IRQ_
\ No newline at end of file
+#endif // __DSG_KEYPAD_
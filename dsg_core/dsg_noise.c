@@ -0,0 +1,64 @@
+/**
+ * \file        dsg_noise.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_noise.h"
+
+
+void ng_init(noise_gen_t *ng, uint32_t seed, uint8_t prbs)
+{
+    ng->xs = seed ? seed : NG_SEED;
+    ng->pcnt = 0;
+    ng->psum = 0;
+    for (uint8_t i = 0; i < NG_ROWS; i++){
+        ng->rows[i] = 0;
+    }
+    ng_set_prbs(ng, prbs);
+}
+
+void ng_set_prbs(noise_gen_t *ng, uint8_t prbs)
+{
+    switch(prbs){
+        case 15:
+            ng->ptap = 14;
+            break;
+        case 23:
+            ng->ptap = 18;
+            break;
+        default:
+            prbs = 7;
+            ng->ptap = 6;
+            break;
+    }
+    ng->prbs = prbs;
+    ng->lfsr = (1UL << prbs) - 1; // Any state different of zero
+}
+
+uint8_t ng_prbs_bit(noise_gen_t *ng)
+{
+    uint32_t bit = ((ng->lfsr >> (ng->prbs - 1)) ^ (ng->lfsr >> (ng->ptap - 1))) & 0x01;
+    ng->lfsr = ((ng->lfsr << 1) | bit) & ((1UL << ng->prbs) - 1);
+    return (uint8_t)bit;
+}
+
+int32_t ng_pink(noise_gen_t *ng)
+{
+    ng->pcnt++;
+    uint8_t k = ng->pcnt ? (uint8_t)__builtin_ctz(ng->pcnt) : NG_ROWS;
+    if(k < NG_ROWS){
+        int16_t row = (int16_t)((int32_t)(ng_white(ng) >> 20) - 2048);
+        ng->psum += row - ng->rows[k];
+        ng->rows[k] = row;
+    }
+    return ng->psum + (int32_t)(ng_white(ng) >> 20) - 2048;
+}
@@ -0,0 +1,95 @@
+/**
+ * \file        dsg_noise.h
+ * \brief       Noise sources: white (xorshift32), pink (Voss-McCartney) and PRBS.
+ * \details     Only the sequences, without the DAC: the variants convert them to codes
+ * (dsg_noise_buf.c), and the host test checks them bit by bit (test/test_noise.c).
+ *
+ * PRBS polynomials (ITU-T O.150), the register is shifted to the left and the new bit is
+ * the XOR of the two taps:
+ *      PRBS-7:  x^7 + x^6 + 1
+ *      PRBS-15: x^15 + x^14 + 1
+ *      PRBS-23: x^23 + x^18 + 1
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_NOISE_
+#define __DSG_NOISE_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define NG_ROWS     8           // Rows of the Voss-McCartney pink noise generator
+#define NG_SEED     0x2545F491  // Seed of the xorshift32 when 0 is given
+#define NG_PINK_MAX ((NG_ROWS + 1)*2048) // Range of ng_pink(): -NG_PINK_MAX to NG_PINK_MAX
+
+/**
+ * @typedef noise_gen_t
+ *
+ * @brief State of the noise sources
+ *
+ */
+typedef struct{
+    uint32_t xs;                    // xorshift32 state
+    uint32_t lfsr;                  // PRBS shift register
+    uint8_t prbs;                   // PRBS order: 7, 15 or 23
+    uint8_t ptap;                   // Second tap of the PRBS polynomial
+    uint32_t pcnt;                  // Counter to select the pink noise row to update
+    int16_t rows[NG_ROWS];          // Pink noise rows
+    int32_t psum;                   // Sum of the pink noise rows
+}noise_gen_t;
+
+/**
+ * @brief Initialize the noise sources
+ *
+ * @param ng
+ * @param seed Seed of the xorshift32 generator, NG_SEED if it is 0
+ * @param prbs PRBS order: 7, 15 or 23
+ */
+void ng_init(noise_gen_t *ng, uint32_t seed, uint8_t prbs);
+
+/**
+ * @brief Change the PRBS order. The register is reloaded with all ones.
+ *
+ * @param ng
+ * @param prbs 7, 15 or 23, any other value is 7
+ */
+void ng_set_prbs(noise_gen_t *ng, uint8_t prbs);
+
+/**
+ * @brief Next bit of the PRBS sequence.
+ *
+ * @param ng
+ * @return uint8_t
+ */
+uint8_t ng_prbs_bit(noise_gen_t *ng);
+
+/**
+ * @brief Next value of the pink noise, from -NG_PINK_MAX to NG_PINK_MAX.
+ * Each row is updated at half the rate of the previous one (Voss-McCartney),
+ * the sum has a spectrum that falls about 3dB per octave.
+ *
+ * @param ng
+ * @return int32_t
+ */
+int32_t ng_pink(noise_gen_t *ng);
+
+/**
+ * @brief Next value of the white noise (xorshift32).
+ *
+ * @param ng
+ * @return uint32_t
+ */
+static inline uint32_t ng_white(noise_gen_t *ng)
+{
+    uint32_t x = ng->xs;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ng->xs = x;
+    return x;
+}
+
+#endif // __DSG_NOISE_
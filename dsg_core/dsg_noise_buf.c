@@ -0,0 +1,68 @@
+/**
+ * \file        dsg_noise_buf.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_noise_buf.h"
+#include "dsg_dac.h"
+
+
+void noise_init(noise_t *noise, uint32_t seed, uint8_t prbs)
+{
+    noise->rd = 0;
+    noise->active = 0;
+    noise->refill = 0;
+    noise->underrun = 0;
+    ng_init(&noise->gen, seed, prbs);
+}
+
+static void noise_fill_block(noise_t *noise, signal_t *signal, const dac_t *dac, uint16_t *blk)
+{
+    uint16_t lo = dac_code(dac, (int16_t)(signal->offset - signal->amp));
+    uint16_t hi = dac_code(dac, (int16_t)(signal->offset + signal->amp));
+
+    switch(signal->STATE.ss){
+        case 4: // White noise
+            for (uint16_t i = 0; i < NOISE_BLOCK; i++){
+                blk[i] = lo + (uint16_t)(((ng_white(&noise->gen) >> 16)*(uint32_t)(hi - lo + 1)) >> 16);
+            }
+            break;
+        case 5: // Pink noise
+            for (uint16_t i = 0; i < NOISE_BLOCK; i++){
+                int32_t v = ng_pink(&noise->gen)*signal->amp/NG_PINK_MAX;
+                blk[i] = dac_code(dac, (int16_t)(signal->offset + v));
+            }
+            break;
+        case 6: // PRBS
+            for (uint16_t i = 0; i < NOISE_BLOCK; i++){
+                blk[i] = ng_prbs_bit(&noise->gen) ? hi : lo;
+            }
+            break;
+    }
+}
+
+void noise_restart(noise_t *noise, signal_t *signal, const dac_t *dac)
+{
+    noise_fill_block(noise, signal, dac, noise->blk[0]);
+    noise_fill_block(noise, signal, dac, noise->blk[1]);
+    noise->rd = 0;
+    noise->active = 0;
+    noise->refill = 0;
+}
+
+void noise_fill(noise_t *noise, signal_t *signal, const dac_t *dac)
+{
+    if(!noise->refill) return;
+
+    noise_fill_block(noise, signal, dac, noise->blk[noise->active ^ 1]);
+    noise->refill = 0;
+}
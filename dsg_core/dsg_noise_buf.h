@@ -0,0 +1,102 @@
+/**
+ * \file        dsg_noise_buf.h
+ * \brief       Noise generator: white (xorshift32), pink (Voss-McCartney) and PRBS.
+ * \details     The samples are not calculated in the signal ISR. They are generated
+ * in blocks of NOISE_BLOCK DAC codes into two buffers: while one of them is being
+ * output, the other one is filled from the main loop. The ISR only reads a code,
+ * as it does with the table of the periodic waveforms.
+ *
+ * The sequences are the ones of dsg_noise.h, which the host test checks.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_NOISE_BUF_
+#define __DSG_NOISE_BUF_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_noise.h"
+
+#include "dsg_signal.h"
+#include "dsg_dac.h"
+
+#define NOISE_BLOCK     256     // Codes per buffer
+
+/**
+ * @typedef noise_t
+ *
+ * @brief Structure to manage the noise generator and its output buffers
+ *
+ */
+typedef struct{
+    uint16_t blk[2][NOISE_BLOCK];   // Output buffers with DAC codes
+    uint16_t rd;                    // Read position in the active buffer
+    uint8_t active;                 // Buffer being output
+    volatile uint8_t refill;        // The buffer that is not active must be filled
+    uint32_t underrun;              // Times that a buffer was output again because it was not filled on time
+    noise_gen_t gen;                // Sequences of the white, pink and PRBS noise
+}noise_t;
+
+/**
+ * @brief Initialize the noise generator
+ *
+ * @param noise
+ * @param seed Seed of the xorshift32 generator, NG_SEED if it is 0
+ * @param prbs PRBS order: 7, 15 or 23
+ */
+void noise_init(noise_t *noise, uint32_t seed, uint8_t prbs);
+
+/**
+ * @brief Fill both buffers and start the output from the first one.
+ * Used when the waveform or its parameters change.
+ *
+ * @param noise
+ * @param signal
+ * @param dac   Its calibration is used to convert the values
+ */
+void noise_restart(noise_t *noise, signal_t *signal, const dac_t *dac);
+
+/**
+ * @brief Fill the buffer that is not being output, if it is needed.
+ *
+ * @param noise
+ * @param signal
+ * @param dac
+ */
+void noise_fill(noise_t *noise, signal_t *signal, const dac_t *dac);
+
+/**
+ * @brief Change the PRBS order. The register is reloaded with all ones.
+ *
+ * @param noise
+ * @param prbs 7, 15 or 23
+ */
+static inline void noise_set_prbs(noise_t *noise, uint8_t prbs)
+{
+    ng_set_prbs(&noise->gen, prbs);
+}
+
+/**
+ * @brief Get the next code of the active buffer. Called from the signal ISR.
+ *
+ * @param noise
+ * @return uint16_t
+ */
+static inline uint16_t noise_next(noise_t *noise)
+{
+    uint16_t code = noise->blk[noise->active][noise->rd];
+    if(++noise->rd >= NOISE_BLOCK){
+        noise->rd = 0;
+        noise->active ^= 1;
+        if(noise->refill)
+            noise->underrun++;
+        noise->refill = 1;
+    }
+    return code;
+}
+
+#endif // __DSG_NOISE_BUF_
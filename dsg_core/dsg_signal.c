@@ -0,0 +1,71 @@
+/**
+ * \file        dsg_signal.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsg_signal.h"
+
+
+void signal_gen_init(signal_t *signal, uint32_t freq, uint16_t amp, uint16_t offset, bool en)
+{
+    signal->freq = freq;
+    signal->amp = amp;
+    signal->offset = offset;
+    signal->value = 0;
+    signal->STATE.en = en;
+    signal->STATE.ss = 0;
+    signal->STATE.interp = 0;
+    signal->STATE.dma = 0;
+    signal->cnt = 0;
+    signal->phase = 0;
+    signal->duty[0] = 0;    // Not used by the sinusoidal
+    signal->duty[1] = 500;  // Symmetric triangular
+    signal->duty[2] = 1000; // Rising saw tooth
+    signal->duty[3] = 500;  // 50% square
+    signal->t_sample = S_TO_US/(SAMPLE*freq);
+}
+
+void signal_calculate(signal_t *signal)
+{
+    if(!signal->STATE.en) return; 
+
+    signal_values(signal, signal->arrayV, SAMPLE);
+}
+
+void signal_values(signal_t *signal, int16_t *values, uint16_t n)
+{
+    switch(signal->STATE.ss){ // Calculate next signal value
+        case 0: // Sinusoidal
+            for (uint16_t i = 1; i <= n; i++){
+                signal_gen_sin(signal, i, n);
+                values[i - 1] = signal->value;
+            }
+            break;
+        case 1: // Triangular
+            for (uint16_t i = 1; i <= n; i++){
+                signal_gen_tri(signal, i, n);
+                values[i - 1] = signal->value;
+            }
+            break;
+        case 2: // Saw tooth
+            for (uint16_t i = 1; i <= n; i++){
+                signal_gen_saw(signal, i, n);
+                values[i - 1] = signal->value;
+            }
+            break;
+        case 3: // Square
+            for (uint16_t i = 1; i <= n; i++){
+                signal_gen_sqr(signal, i, n);
+                values[i - 1] = signal->value;
+            }
+            break;
+    }
+}
@@ -0,0 +1,232 @@
+/**
+ * \file        dsg_signal.h
+ * \brief       Signal generator of the variants: one period of SAMPLE values in mV.
+ * \details     The table is converted to DAC codes (dac_codes() of dsg_dac.h) and output by
+ * the variant, one code each t_sample us. The triangular, saw tooth and square waveforms
+ * have a duty cycle or symmetry, and the channel B of irq_c a phase. The noise waveforms
+ * are not periodic, they have no table (see dsg_noise_buf.h). irq_c also plays the
+ * waveforms from an interpolated wavetable (STATE.interp) or by DMA (STATE.dma), the
+ * polling variants only use the table of SAMPLE points.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_SIGNAL_
+#define __DSG_SIGNAL_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI		3.14159265358979323846	/* pi */
+#endif
+#define S_TO_US    1000000     ///< 1000000us = 1s
+#define US_TO_S    0.000001    // 1us = 0.000001s
+#define SAMPLE  70      // Nyquist theorem
+#define SIGNAL_STATES   7   // Number of waveforms
+#define SIGNAL_PERIODIC 4   // Number of periodic waveforms, the next ones are noise
+
+/**
+ * @typedef signal_t 
+ * 
+ * @brief Structure to manage a signal generator
+ * 
+ */
+typedef struct{
+    struct{
+        uint8_t ss      : 3;    // Signal State -> 0: Sinusoidal, 1: Triangular, 2: Saw tooth, 3: Square, 4: White noise, 5: Pink noise, 6: PRBS
+        uint8_t en      : 1;    // Enable signal generation
+        uint8_t interp  : 1;    // Playback mode -> 0: SAMPLE points per period, 1: Interpolated wavetable
+        uint8_t dma     : 1;    // The SAMPLE points table is output by DMA, not by the signal ISR
+    }STATE;
+    uint32_t freq;          // Signal frequency
+    uint16_t amp;           // Signal amplitude
+    uint16_t offset;        // Signal offset
+    int16_t value;          // Signal value
+    int16_t arrayV[SAMPLE]; // Array to store the signal values for the DAC
+    uint16_t arrayC[SAMPLE]; // DAC codes of arrayV, converted when the table is built
+    uint8_t cnt;            // Time variable
+    uint16_t t_sample;      // Sample time
+    uint16_t phase;         // Phase in degrees with respect to the first channel
+    uint16_t duty[SIGNAL_PERIODIC]; // Symmetry (triangular, saw tooth) or duty cycle (square) in tenths of percent
+}signal_t;
+
+
+/**
+ * @brief Initialize the signal generator
+ * 
+ * @param signal 
+ * @param freq in Hz
+ * @param amp in mV
+ * @param offset in mV
+ * @param en 
+ */
+void signal_gen_init(signal_t *signal, uint32_t freq, uint16_t amp, uint16_t offset, bool en);
+
+// ------------------------------------------------------------------
+// ---------------------- GETTING WAVE VALUES -----------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief This function calculates the values of the signal and stores them in the arrayV.
+ * 
+ * @param signal 
+ */
+void signal_calculate(signal_t *signal);
+
+/**
+ * @brief Calculate one period of n values of the periodic waveforms, t from 1 to n as 
+ * signal_calculate(). Used for the tables of other sizes, as the interpolated wavetable.
+ * 
+ * @param signal 
+ * @param values n values in mV
+ * @param n Number of points per period
+ */
+void signal_values(signal_t *signal, int16_t *values, uint16_t n);
+
+/**
+ * @brief This function calculates the value of a sinusoidal signal
+ * 
+ * @param signal 
+ * @param t Point of the period, from 0 to n
+ * @param n Number of points per period
+ */
+static inline void signal_gen_sin(signal_t *signal, uint16_t t, uint16_t n)
+{
+    signal->value = (int16_t)(signal->offset + signal->amp*sin((2*M_PI*t)/n));
+}
+
+/**
+ * @brief This function calculates the value of a ramp that goes from -amp to amp 
+ * in the first d/1000 of the period and comes back in the rest of it. 
+ * The comparison is made with t*1000 against d*n, so the peak can be placed between points.
+ * 
+ * @param signal 
+ * @param t Point of the period, from 0 to n
+ * @param n Number of points per period
+ * @param d Position of the peak in tenths of percent of the period
+ */
+static inline void signal_gen_ramp(signal_t *signal, uint16_t t, uint16_t n, uint16_t d)
+{
+    int32_t tt = (int32_t)t*1000;
+    int32_t tp = (int32_t)d*n;
+    if (d && tt <= tp){
+        signal->value = (int16_t)(signal->offset - signal->amp + (2*signal->amp*tt)/tp);
+    }
+    else {
+        signal->value = (int16_t)(signal->offset + signal->amp - (2*signal->amp*(tt - tp))/((int32_t)(1000 - d)*n));
+    }
+}
+
+/**
+ * @brief This function calculates the value of a triangular signal. 
+ * Its symmetry is the position of the peak: duty[1].
+ * 
+ * @param signal 
+ * @param t Point of the period, from 0 to n
+ * @param n Number of points per period
+ */
+static inline void signal_gen_tri(signal_t *signal, uint16_t t, uint16_t n)
+{
+    signal_gen_ramp(signal, t, n, signal->duty[1]);
+}
+
+/**
+ * @brief This function calculates the value of a saw tooth signal.
+ * Its symmetry is the position of the peak: duty[2], 1000 is the classic rising saw tooth.
+ * 
+ * @param signal 
+ * @param t Point of the period, from 0 to n
+ * @param n Number of points per period
+ */
+static inline void signal_gen_saw(signal_t *signal, uint16_t t, uint16_t n)
+{
+    signal_gen_ramp(signal, t, n, signal->duty[2]);
+}
+
+/**
+ * @brief This function calculates the value of a square signal.
+ * The duty cycle is duty[3]. If it is not zero, at least one point is high,
+ * so narrow pulses last one sample clock.
+ * 
+ * @param signal 
+ * @param t Point of the period, from 0 to n
+ * @param n Number of points per period
+ */
+static inline void signal_gen_sqr(signal_t *signal, uint16_t t, uint16_t n)
+{
+    uint32_t high = (uint32_t)signal->duty[3]*n/1000;
+    if (signal->duty[3] && !high){
+        high = 1;
+    }
+    if (t <= high){
+        signal->value = (int16_t)(signal->offset + signal->amp);
+    }
+    else {
+        signal->value = (int16_t)(signal->offset - signal->amp);
+    }
+}
+
+// ------------------------------------------------------------------
+// ------------------------------------------------------------------
+
+static inline int16_t signal_get_value(signal_t *signal){
+    return signal->value;
+}
+
+static inline void signal_set_state(signal_t *signal, uint8_t ss){
+    signal->STATE.ss = ss;
+}
+
+/**
+ * @brief The noise waveforms are not periodic, they are not stored in arrayV.
+ * 
+ * @param signal 
+ * @return true if the current waveform is a noise
+ */
+static inline bool signal_is_noise(signal_t *signal){
+    return signal->STATE.ss >= SIGNAL_PERIODIC;
+}
+
+static inline void signal_set_amp(signal_t *signal, uint16_t amp){
+    signal->amp = amp;
+}
+
+static inline void signal_set_offset(signal_t *signal, uint16_t offset){
+    signal->offset = offset;
+}
+
+static inline void signal_set_freq(signal_t *signal, uint32_t freq){
+    signal->freq = freq;
+    signal->t_sample = S_TO_US/(SAMPLE*freq); // Nyquist theorem
+}
+
+static inline void signal_set_phase(signal_t *signal, uint16_t phase){
+    signal->phase = phase%360;
+}
+
+/**
+ * @brief Set the duty cycle or the symmetry of the current waveform. 
+ * It is applied when the values are calculated, so it does not cost anything per sample.
+ * 
+ * @param signal 
+ * @param duty in tenths of percent, from 0 to 1000
+ */
+static inline void signal_set_duty(signal_t *signal, uint16_t duty){
+    if(signal->STATE.ss < SIGNAL_PERIODIC)
+        signal->duty[signal->STATE.ss] = duty;
+}
+
+static inline void signal_gen_enable(signal_t *signal){
+    signal->STATE.en = 1;
+}
+
+static inline void signal_gen_disable(signal_t *signal){
+    signal->STATE.en = 0;
+}
+
+
+#endif // __DSG_SIGNAL_
@@ -0,0 +1,163 @@
+/**
+ * \file        dsg_task.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "dsg_hal.h"
+#include "dsg_task.h"
+
+/**
+ * \brief Sort the queue by wake time again (insertion sort). The wake times only change
+ * for the tasks of the last pass, the queue is almost sorted and it is O(n).
+ */
+static void tk_sort(sched_t *sched)
+{
+    for (uint8_t i = 1; i < sched->n; i++){
+        task_t *t = sched->queue[i];
+        uint8_t j = i;
+        while(j > 0 && sched->queue[j - 1]->wake > t->wake){
+            sched->queue[j] = sched->queue[j - 1];
+            j--;
+        }
+        sched->queue[j] = t;
+    }
+}
+
+/**
+ * \brief Earliest wake time after clock of the tasks with more priority than t
+ */
+static uint64_t tk_limit(sched_t *sched, task_t *t, uint64_t clock)
+{
+    uint64_t limit = UINT64_MAX;
+    for (uint8_t i = 0; i < t->prio; i++){
+        uint64_t wake = sched->task[i]->wake;
+        if(wake > clock && wake < limit)
+            limit = wake;
+    }
+    return limit;
+}
+
+void tk_init(sched_t *sched)
+{
+    sched->n = 0;
+    sched->start = hal_time_us();
+    sched->next = 0;
+    sched->passes = 0;
+}
+
+void tk_add(sched_t *sched, task_t *task, const char *name, task_fn_t fn, uint32_t budget)
+{
+    task->name = name;
+    task->fn = fn;
+    task->lc = 0;
+    task->prio = sched->n;
+    task->now = 0;
+    task->gpios = 0;
+    task->wake = 0;
+    task->ready = 0;
+    task->budget = budget;
+    task->busy = 0;
+    task->runs = 0;
+    task->max = 0;
+    task->overrun = 0;
+    task->defer = 0;
+    sched->task[sched->n] = task;
+    sched->queue[sched->n] = task;
+    sched->n++;
+    tk_sort(sched);
+}
+
+bool tk_run(sched_t *sched)
+{
+    bool done = false;
+    bool deferred = false;
+    uint64_t now = hal_time_us();        // Sample of the pass, the same for all the tasks
+    uint32_t gpios = hal_gpio_get_all();
+    uint64_t clock = now;                // Time after the last call
+
+    tk_sort(sched); // tk_wake_at() and tk_notify() can be called out of the tasks too
+    sched->passes++;
+    for (uint8_t i = 0; i < sched->n; i++){
+        task_t *t = sched->queue[i];
+
+        if(now < t->wake)
+            break; // The following ones are not due either
+        // Its budget does not fit before a task with more priority must run
+        if(clock + t->budget > tk_limit(sched, t, clock)){
+            if(!t->ready)
+                t->ready = now;
+            if(now - t->ready < TK_DEFER_MAX_US){
+                t->defer++;
+                deferred = true;
+                continue;
+            }
+        }
+        t->ready = 0;
+
+        t->now = now;
+        t->gpios = gpios;
+        uint64_t t0 = hal_time_us();
+        uint8_t res = t->fn(t);
+        clock = hal_time_us();
+        uint32_t dt = (uint32_t)(clock - t0);
+
+        t->busy += dt;
+        t->runs++;
+        if(dt > t->max)
+            t->max = dt;
+        if(dt > t->budget)
+            t->overrun++;
+        if(res != TK_WAITING)
+            done = true;
+    }
+    // The tasks called and the ones notified by them have a new wake time
+    tk_sort(sched);
+    sched->next = deferred ? now : (sched->n ? sched->queue[0]->wake : UINT64_MAX);
+    return done;
+}
+
+void tk_sleep(sched_t *sched)
+{
+    if(sched->next > hal_time_us() + TK_SLEEP_MIN_US){
+        hal_sleep_until(sched->next - TK_SLEEP_MARGIN_US);
+    }
+}
+
+void tk_report(sched_t *sched)
+{
+    uint64_t now = hal_time_us();
+    uint32_t elapsed = (uint32_t)(now - sched->start);
+    uint32_t busy = 0;
+
+    if(!elapsed)
+        elapsed = 1;
+    for (uint8_t i = 0; i < sched->n; i++){
+        task_t *t = sched->task[i];
+        uint32_t share = (uint32_t)((uint64_t)t->busy*1000/elapsed); // In 0.1%
+        printf("%-8s %3lu.%lu%% runs: %lu max: %lu us over: %lu defer: %lu\n", t->name,
+            (unsigned long)(share/10), (unsigned long)(share%10), (unsigned long)t->runs,
+            (unsigned long)t->max, (unsigned long)t->overrun, (unsigned long)t->defer);
+        busy += t->busy;
+        t->busy = 0;
+        t->runs = 0;
+        t->max = 0;
+        t->overrun = 0;
+        t->defer = 0;
+    }
+    uint32_t share = (uint32_t)((uint64_t)(elapsed > busy ? elapsed - busy : 0)*1000/elapsed);
+    printf("%-8s %3lu.%lu%%\n", "idle", (unsigned long)(share/10), (unsigned long)(share%10)); // Scheduler, idle passes and sleep
+    // Mean period of the passes, the loop of the variant
+    uint32_t period = sched->passes ? (uint32_t)((uint64_t)elapsed*1000/sched->passes) : 0;
+    printf("%-8s %lu passes, %lu ns per pass\n", "loop", (unsigned long)sched->passes, (unsigned long)period);
+    sched->passes = 0;
+    sched->start = now;
+}
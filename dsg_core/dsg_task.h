@@ -0,0 +1,148 @@
+/**
+ * \file        dsg_task.h
+ * \brief       Stackless tasks (protothreads) and a cooperative scheduler.
+ * \details     A task is a function that the scheduler calls again and again. It runs
+ * until it has to wait for a time or an event, then it returns, and in the next call it
+ * continues from the same line: the line is saved in the task (local continuation) and
+ * TK_BEGIN() jumps to it with a switch. The tasks do not need a stack of their own, but:
+ *  - The local variables are lost when the task waits, static variables must be used.
+ *  - Only one wait per line, and a task can not wait inside a switch of its own.
+ *
+ * The tasks are kept in a queue sorted by their wake time (earliest deadline first): a
+ * pass of the scheduler calls the due ones from the head and stops at the first one that
+ * is not due. The time and the GPIOs are read once per pass, all the tasks of the pass get
+ * the same sample in now and gpios.
+ * A task is deferred while its budget does not fit before the wake time of a task with
+ * more priority (the order in which they were added), so the sample output is not delayed
+ * by the other tasks. A deferred task runs anyway after TK_DEFER_MAX_US.
+ * The run time of each call and the passes are counted to report the CPU share and the
+ * loop period.
+ *
+ * Used by polling_c, whose tasks wait for its time bases, and by polling_irq_c, whose
+ * tasks wait for the flags set by the ISRs. A task that waits for a periodic interrupt
+ * can announce the time of the next one with tk_wake_at().
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DSG_TASK_
+#define __DSG_TASK_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TK_TASKS            8           ///< Max tasks of a scheduler
+#define TK_DEFER_MAX_US     100000      ///< Max time that a task can be deferred
+#define TK_SLEEP_MIN_US     50          ///< Shorter idle times are not slept
+#define TK_SLEEP_MARGIN_US  10          ///< The core wakes up before the next task, it is not late
+
+#define TK_WAITING          0           ///< The task is waiting, nothing was done
+#define TK_YIELDED          1           ///< The task did something and gave the CPU back
+#define TK_ENDED            2           ///< The task ended, it starts again in the next call
+
+typedef struct task task_t;
+typedef uint8_t (*task_fn_t)(task_t *task);
+
+/**
+ * \typedef task_t
+ * \brief State and statistics of a task
+ */
+struct task{
+    const char *name;
+    task_fn_t fn;
+    uint16_t lc;                ///< Local continuation: line where the task continues
+    uint8_t prio;               ///< Priority, 0 is the highest
+    uint64_t now;               ///< Time of the pass, set by the scheduler
+    uint32_t gpios;             ///< GPIOs read in the pass, set by the scheduler
+    uint64_t wake;              ///< The task is not called before this time
+    uint64_t ready;             ///< Time since the task is being deferred, 0 if it is not
+    uint32_t budget;            ///< Max run time of one call in us
+    uint32_t busy;              ///< Run time in us since the last report
+    uint32_t runs;              ///< Calls since the last report
+    uint32_t max;               ///< Longest call in us since the last report
+    uint32_t overrun;           ///< Calls longer than the budget since the last report
+    uint32_t defer;             ///< Passes of the scheduler in which the task was deferred
+};
+
+/**
+ * \typedef sched_t
+ * \brief Tasks by priority, the first one has the highest, and the same tasks sorted by
+ * their wake time
+ */
+typedef struct{
+    task_t *task[TK_TASKS];
+    task_t *queue[TK_TASKS];    ///< Earliest wake time first
+    uint8_t n;
+    uint64_t start;             ///< Time of the last report
+    uint64_t next;              ///< Earliest wake time after the last pass
+    uint32_t passes;            ///< Passes since the last report
+}sched_t;
+
+#define TK_BEGIN(t)             switch((t)->lc){ case 0:
+#define TK_END(t)               } (t)->lc = 0; return TK_ENDED
+
+/// @brief Wait until cond is true, it is evaluated in each call of the task
+#define TK_WAIT_UNTIL(t, cond)  do{ (t)->lc = __LINE__; case __LINE__: if(!(cond)) return TK_WAITING; }while(0)
+
+/// @brief Wait until cond is true, it is evaluated again only after tk_notify()
+#define TK_WAIT_EVENT(t, cond)  do{ (t)->lc = __LINE__; case __LINE__: if(!(cond)){ (t)->wake = UINT64_MAX; return TK_WAITING; } }while(0)
+
+/// @brief Give the CPU back, the task continues in the next pass of the scheduler
+#define TK_YIELD(t)             do{ (t)->lc = __LINE__; return TK_YIELDED; case __LINE__:; }while(0)
+
+/// @brief Wait us microseconds, the scheduler does not call the task meanwhile
+#define TK_DELAY(t, us)         do{ (t)->wake = (t)->now + (us); TK_WAIT_UNTIL(t, (t)->now >= (t)->wake); }while(0)
+
+/**
+ * \brief The task is not called before a time, usually the next interrupt it waits for
+ * \param t    Task
+ * \param at   Time in us
+ */
+static inline void tk_wake_at(task_t *t, uint64_t at){
+    t->wake = at;
+}
+
+/**
+ * \brief Wake up a task that waits in TK_WAIT_EVENT()
+ * \param t    Task
+ */
+static inline void tk_notify(task_t *t){
+    t->wake = 0;
+}
+
+void tk_init(sched_t *sched);
+
+/**
+ * \brief Add a task with less priority than the ones already added
+ * \param sched    Scheduler
+ * \param task     Task
+ * \param name     Name for the report
+ * \param fn       Function of the task
+ * \param budget   Max run time of one call in us
+ */
+void tk_add(sched_t *sched, task_t *task, const char *name, task_fn_t fn, uint32_t budget);
+
+/**
+ * \brief One pass of the scheduler: the due tasks are called once, the earliest first
+ * \param sched    Scheduler
+ * \return         True if any task yielded or ended: it must run again before sleeping
+ */
+bool tk_run(sched_t *sched);
+
+/**
+ * \brief Sleep until the earliest wake time of the tasks, if it is far enough.
+ * Any interrupt or event wakes the core up before.
+ * \param sched    Scheduler
+ */
+void tk_sleep(sched_t *sched);
+
+/**
+ * \brief Print the CPU share and the statistics of each task since the last report,
+ * and the mean period of the passes (loop)
+ * \param sched    Scheduler
+ */
+void tk_report(sched_t *sched);
+
+#endif // __DSG_TASK_
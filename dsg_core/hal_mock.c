@@ -0,0 +1,138 @@
+/**
+ * \file        hal_mock.c
+ * \brief       dsg_hal.h in memory, for the host build
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "dsg_hal.h"
+#include "hal_mock.h"
+
+#define HAL_MOCK_IRQS   32
+
+static uint32_t gOut;                   // Output values
+static uint32_t gOe;                    // Output enables
+static uint32_t gIn;                    // Input values
+static uint32_t gWrites;
+static uint32_t gIrqGpio;               // GPIOs with the rising edge interrupt enabled
+static hal_gpio_cb_t gGpioCb;
+static hal_irq_handler_t gHandler[HAL_MOCK_IRQS];
+static uint32_t gIrqEn;
+static bool gVirtual;                   // The time is set by hal_mock_set_time()
+static uint64_t gTime;
+
+void hal_gpio_init_mask(uint32_t mask)
+{
+    gOe &= ~mask;
+    gOut &= ~mask;
+}
+
+void hal_gpio_set_dir_masked(uint32_t mask, uint32_t out)
+{
+    gOe = (gOe & ~mask) | (out & mask);
+}
+
+void hal_gpio_pull_down_mask(uint32_t mask)
+{
+    (void)mask;
+}
+
+void hal_gpio_put_masked(uint32_t mask, uint32_t value)
+{
+    gOut = (gOut & ~mask) | (value & mask);
+    gWrites++;
+}
+
+uint32_t hal_gpio_get_all(void)
+{
+    return (gOut & gOe) | (gIn & ~gOe);
+}
+
+void hal_gpio_irq_set(uint8_t gpio, bool en, hal_gpio_cb_t cb)
+{
+    if(cb)
+        gGpioCb = cb;
+    if(en)
+        gIrqGpio |= 1u << gpio;
+    else
+        gIrqGpio &= ~(1u << gpio);
+}
+
+uint64_t hal_time_us(void)
+{
+    if(gVirtual)
+        return gTime;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+}
+
+void hal_sleep_until(uint64_t us)
+{
+    if(gVirtual){
+        if(us > gTime)
+            gTime = us;
+        return;
+    }
+    uint64_t now = hal_time_us();
+    if(us > now){
+        struct timespec ts = {(time_t)((us - now)/1000000), (long)((us - now)%1000000)*1000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+void hal_irq_set_handler(uint8_t irq, hal_irq_handler_t handler, uint8_t priority)
+{
+    (void)priority;
+    gHandler[irq % HAL_MOCK_IRQS] = handler;
+    gIrqEn |= 1u << (irq % HAL_MOCK_IRQS);
+}
+
+void hal_irq_set_enabled(uint8_t irq, bool en)
+{
+    if(en)
+        gIrqEn |= 1u << (irq % HAL_MOCK_IRQS);
+    else
+        gIrqEn &= ~(1u << (irq % HAL_MOCK_IRQS));
+}
+
+uint32_t hal_mock_outputs(void)
+{
+    return gOut;
+}
+
+uint32_t hal_mock_writes(void)
+{
+    return gWrites;
+}
+
+void hal_mock_set_inputs(uint32_t inputs)
+{
+    gIn = inputs;
+}
+
+void hal_mock_set_time(uint64_t us)
+{
+    gVirtual = true;
+    gTime = us;
+}
+
+void hal_mock_gpio_edge(uint8_t gpio)
+{
+    if(gGpioCb && (gIrqGpio & (1u << gpio)))
+        gGpioCb(gpio, 0x8u); // GPIO_IRQ_EDGE_RISE
+}
+
+void hal_mock_irq(uint8_t irq)
+{
+    irq %= HAL_MOCK_IRQS;
+    if(gHandler[irq] && (gIrqEn & (1u << irq)))
+        gHandler[irq]();
+}
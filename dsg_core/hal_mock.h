@@ -0,0 +1,64 @@
+/**
+ * \file        hal_mock.h
+ * \brief       Access to the state of the mock HAL, for the host build.
+ * \details     The GPIOs are two words in memory: the outputs written by the modules and
+ * the inputs set by the host program. The time is the monotonic clock of the host,
+ * or a virtual time when hal_mock_set_time() was called. The interrupts are raised by
+ * hal_mock_gpio_edge() and hal_mock_irq().
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __HAL_MOCK_
+#define __HAL_MOCK_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_hal.h"
+
+/**
+ * @brief Outputs written by the modules
+ *
+ * @return uint32_t
+ */
+uint32_t hal_mock_outputs(void);
+
+/**
+ * @brief Number of writes of a GPIO mask since the start
+ *
+ * @return uint32_t
+ */
+uint32_t hal_mock_writes(void);
+
+/**
+ * @brief Set the inputs read by hal_gpio_get_all(). The outputs are read back.
+ *
+ * @param inputs
+ */
+void hal_mock_set_inputs(uint32_t inputs);
+
+/**
+ * @brief Use a virtual time, it only changes with this function and hal_sleep_until()
+ *
+ * @param us
+ */
+void hal_mock_set_time(uint64_t us);
+
+/**
+ * @brief Rising edge on a GPIO: the callback is called if its interrupt is enabled
+ *
+ * @param gpio
+ */
+void hal_mock_gpio_edge(uint8_t gpio);
+
+/**
+ * @brief Call the handler of an interrupt if it is enabled
+ *
+ * @param irq
+ */
+void hal_mock_irq(uint8_t irq);
+
+#endif // __HAL_MOCK_
@@ -0,0 +1,76 @@
+/**
+ * \file        hal_pico.c
+ * \brief       dsg_hal.h on the RP2040, with the Pico SDK
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+
+#include "dsg_hal.h"
+
+void hal_gpio_init_mask(uint32_t mask)
+{
+    gpio_init_mask(mask);
+}
+
+void hal_gpio_set_dir_masked(uint32_t mask, uint32_t out)
+{
+    gpio_set_dir_masked(mask, out);
+}
+
+void hal_gpio_pull_down_mask(uint32_t mask)
+{
+    for (uint i = 0; i < 30; i++){
+        if(mask & (1u << i))
+            gpio_pull_down(i);
+    }
+}
+
+void hal_gpio_put_masked(uint32_t mask, uint32_t value)
+{
+    gpio_put_masked(mask, value);
+}
+
+uint32_t hal_gpio_get_all(void)
+{
+    return gpio_get_all();
+}
+
+void hal_gpio_irq_set(uint8_t gpio, bool en, hal_gpio_cb_t cb)
+{
+    if(cb)
+        gpio_set_irq_enabled_with_callback(gpio, GPIO_IRQ_EDGE_RISE, en, cb);
+    else
+        gpio_set_irq_enabled(gpio, GPIO_IRQ_EDGE_RISE, en);
+}
+
+uint64_t hal_time_us(void)
+{
+    return time_us_64();
+}
+
+void hal_sleep_until(uint64_t us)
+{
+    best_effort_wfe_or_timeout(from_us_since_boot(us));
+}
+
+void hal_irq_set_handler(uint8_t irq, hal_irq_handler_t handler, uint8_t priority)
+{
+    irq_set_exclusive_handler(irq, handler);
+    irq_set_priority(irq, priority);
+    irq_set_enabled(irq, true);
+}
+
+void hal_irq_set_enabled(uint8_t irq, bool en)
+{
+    irq_set_enabled(irq, en);
+}
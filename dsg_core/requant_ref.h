@@ -0,0 +1,95 @@
+/**
+ * \file        requant_ref.h
+ * \brief       Requantization of the codes of the tables.
+ * \details     The values are first converted to codes with RQ_FRAC fractional bits
+ * (dac_code_q()), then rounded to the codes of the DAC by one of the modes of dac_codes():
+ * nearest, TPDF dither or first order error feedback. It does not depend on the Pico SDK,
+ * so dsg_spectrum compares the modes on the host with the same arithmetic.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __REQUANT_REF_
+#define __REQUANT_REF_
+
+#include <stdint.h>
+
+#define RQ_FRAC     8                   // Fractional bits of the codes before the requantization
+#define RQ_ONE      (1 << RQ_FRAC)      // 1 LSB
+
+/**
+ * @brief Next value of the dither generator (xorshift32).
+ *
+ * @param x State, must not be 0
+ * @return uint32_t
+ */
+static inline uint32_t rq_ref_rand(uint32_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+/**
+ * @brief Limit a code to the range of the DAC
+ *
+ * @param code
+ * @param max   Code of the full scale
+ * @return uint16_t
+ */
+static inline uint16_t rq_ref_clamp(int32_t code, uint16_t max)
+{
+    return (uint16_t)(code < 0 ? 0 : code > max ? max : code);
+}
+
+/**
+ * @brief Nearest code
+ *
+ * @param q     Code in 1/RQ_ONE LSB
+ * @param max   Code of the full scale
+ * @return uint16_t
+ */
+static inline uint16_t rq_ref_nearest(uint32_t q, uint16_t max)
+{
+    return rq_ref_clamp(((int32_t)q + RQ_ONE/2) >> RQ_FRAC, max);
+}
+
+/**
+ * @brief Code with a triangular dither of +-1 LSB, a new one each call
+ *
+ * @param q     Code in 1/RQ_ONE LSB
+ * @param max   Code of the full scale
+ * @param x     State of rq_ref_rand()
+ * @return uint16_t
+ */
+static inline uint16_t rq_ref_tpdf(uint32_t q, uint16_t max, uint32_t *x)
+{
+    // Sum of two uniform values of 0 to 1 LSB, minus 1 LSB, from the high bits of one draw
+    uint32_t r = rq_ref_rand(x);
+    int32_t t = (int32_t)(r >> (32 - RQ_FRAC)) + (int32_t)((r >> (32 - 2*RQ_FRAC)) & (RQ_ONE - 1)) - (RQ_ONE - 1);
+    return rq_ref_clamp(((int32_t)q + t + RQ_ONE/2) >> RQ_FRAC, max);
+}
+
+/**
+ * @brief Code with the error of the previous one added (1 - z^-1)
+ *
+ * @param q     Code in 1/RQ_ONE LSB
+ * @param max   Code of the full scale
+ * @param err   Error carried to the next code, in 1/RQ_ONE LSB, 0 at the start
+ * @return uint16_t
+ */
+static inline uint16_t rq_ref_shape(uint32_t q, uint16_t max, int32_t *err)
+{
+    int32_t v = (int32_t)q + *err;
+    uint16_t code = rq_ref_clamp((v + RQ_ONE/2) >> RQ_FRAC, max);
+    *err = v - (int32_t)code*RQ_ONE;
+    // Out of the range of the DAC the error is not corrected, it would grow without limit
+    if(*err > 2*RQ_ONE || *err < -2*RQ_ONE)
+        *err = 0;
+    return code;
+}
+
+#endif // __REQUANT_REF_
@@ -0,0 +1,200 @@
+/**
+ * \file        test_noise.c
+ * \brief       Host test of the noise sources of dsg_noise.c.
+ * \details     PRBS: the first 64 bits of each polynomial from the reset state, the
+ * recurrence of the polynomial over a whole period, the period (2^n - 1, the register
+ * returns to all ones and not before) and the balance of a maximal length sequence
+ * (2^(n-1) ones). White and pink: the averaged power spectrum in octave bands, flat
+ * for the white noise and falling 3 dB per octave for the pink noise.
+ * The process returns 0 when every check passes.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsg_noise.h"
+
+#ifndef M_PI
+#define M_PI        3.14159265358979323846
+#endif
+
+#define TEST_NFFT       1024    // Length of the FFT of the spectral checks
+#define TEST_SEGS       512     // Segments averaged
+#define TEST_OCT_LO     3       // Octave bands from TEST_NFFT/2^TEST_OCT_HI to TEST_NFFT/2^TEST_OCT_LO bins
+#define TEST_OCT_HI     8
+#define TEST_FLAT_DB    0.5     // White: max deviation of a band from the mean
+#define TEST_PINK_DB    1.0     // Pink: max deviation of the slope from -3 dB per octave
+
+static int gFail;
+
+/**
+ * @brief Print a check and count it if it fails
+ */
+static void check(bool ok, const char *name, const char *detail)
+{
+    printf("%-4s %-28s %s\n", ok ? "ok" : "FAIL", name, detail);
+    if(!ok)
+        gFail++;
+}
+
+// ------------------------------------------------------------------
+// ------------------------------ PRBS ------------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Bits of a polynomial: the first 64 from the reset state, the recurrence
+ * s[k] = s[k - n] ^ s[k - tap], the period and the balance.
+ */
+static void test_prbs(uint8_t n, uint8_t tap, uint64_t first)
+{
+    noise_gen_t ng;
+    char name[32], detail[96];
+    ng_init(&ng, 0, n);
+
+    uint32_t period = (1UL << n) - 1;
+    uint8_t *s = malloc(period + n);
+    for (uint8_t i = 0; i < n; i++){
+        s[i] = 1; // The register is reset to all ones: the n previous bits
+    }
+
+    uint64_t got = 0;
+    uint32_t ones = 0, len = 0, bad = 0;
+    for (uint32_t k = 0; k < period; k++){
+        uint8_t bit = ng_prbs_bit(&ng);
+        s[k + n] = bit;
+        if(k < 64)
+            got |= (uint64_t)bit << k;
+        if(bit != (s[k] ^ s[k + n - tap]))
+            bad++;
+        ones += bit;
+        if(!len && ng.lfsr == period)
+            len = k + 1; // First return to the reset state
+    }
+    free(s);
+
+    snprintf(name, sizeof(name), "prbs%u first 64 bits", n);
+    snprintf(detail, sizeof(detail), "0x%016llx, expected 0x%016llx", (unsigned long long)got, (unsigned long long)first);
+    check(got == first, name, detail);
+    snprintf(name, sizeof(name), "prbs%u recurrence", n);
+    snprintf(detail, sizeof(detail), "x^%u + x^%u + 1, %lu bits differ", n, tap, (unsigned long)bad);
+    check(!bad, name, detail);
+    snprintf(name, sizeof(name), "prbs%u period", n);
+    snprintf(detail, sizeof(detail), "%lu, expected %lu", (unsigned long)len, (unsigned long)period);
+    check(len == period, name, detail);
+    snprintf(name, sizeof(name), "prbs%u balance", n);
+    snprintf(detail, sizeof(detail), "%lu ones, expected %lu", (unsigned long)ones, (unsigned long)(period + 1)/2);
+    check(ones == (period + 1)/2, name, detail);
+}
+
+// ------------------------------------------------------------------
+// ---------------------------- Spectrum ----------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief In place radix-2 FFT of TEST_NFFT points
+ */
+static void fft(double *re, double *im)
+{
+    for (uint32_t i = 1, j = 0; i < TEST_NFFT; i++){
+        uint32_t bit = TEST_NFFT >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if(i < j){
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    for (uint32_t len = 2; len <= TEST_NFFT; len <<= 1){
+        double a = -2*M_PI/len;
+        for (uint32_t i = 0; i < TEST_NFFT; i += len){
+            for (uint32_t k = 0; k < len/2; k++){
+                double wr = cos(a*k), wi = sin(a*k);
+                double *ur = &re[i + k], *ui = &im[i + k], *vr = &re[i + k + len/2], *vi = &im[i + k + len/2];
+                double tr = *vr*wr - *vi*wi, ti = *vr*wi + *vi*wr;
+                *vr = *ur - tr; *vi = *ui - ti;
+                *ur += tr; *ui += ti;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Mean power per bin in dB of the octave bands, from an averaged Hann windowed spectrum
+ *
+ * @param ng
+ * @param pink  Pink noise, white otherwise
+ * @param band  TEST_OCT_HI - TEST_OCT_LO bands, from the lowest one
+ */
+static void octaves(noise_gen_t *ng, bool pink, double *band)
+{
+    static double re[TEST_NFFT], im[TEST_NFFT], pw[TEST_NFFT/2];
+    memset(pw, 0, sizeof(pw));
+    for (uint32_t s = 0; s < TEST_SEGS; s++){
+        for (uint32_t i = 0; i < TEST_NFFT; i++){
+            double x = pink ? (double)ng_pink(ng) : (double)(int32_t)ng_white(ng);
+            re[i] = x*(0.5 - 0.5*cos(2*M_PI*i/TEST_NFFT));
+            im[i] = 0;
+        }
+        fft(re, im);
+        for (uint32_t k = 0; k < TEST_NFFT/2; k++)
+            pw[k] += re[k]*re[k] + im[k]*im[k];
+    }
+    for (uint8_t o = 0; o < TEST_OCT_HI - TEST_OCT_LO; o++){
+        uint32_t lo = TEST_NFFT >> (TEST_OCT_HI - o), hi = 2*lo;
+        double p = 0;
+        for (uint32_t k = lo; k < hi; k++)
+            p += pw[k];
+        band[o] = 10*log10(p/(hi - lo));
+    }
+}
+
+static void test_white(void)
+{
+    noise_gen_t ng;
+    double band[TEST_OCT_HI - TEST_OCT_LO], mean = 0, dev = 0;
+    char detail[96];
+    ng_init(&ng, 0, 7);
+    octaves(&ng, false, band);
+    for (uint8_t o = 0; o < TEST_OCT_HI - TEST_OCT_LO; o++)
+        mean += band[o]/(TEST_OCT_HI - TEST_OCT_LO);
+    for (uint8_t o = 0; o < TEST_OCT_HI - TEST_OCT_LO; o++)
+        dev = fmax(dev, fabs(band[o] - mean));
+    snprintf(detail, sizeof(detail), "octave bands within %.2f dB, max %.1f", dev, TEST_FLAT_DB);
+    check(dev <= TEST_FLAT_DB, "white flat", detail);
+}
+
+static void test_pink(void)
+{
+    noise_gen_t ng;
+    double band[TEST_OCT_HI - TEST_OCT_LO], worst = -3;
+    char detail[96];
+    ng_init(&ng, 0, 7);
+    octaves(&ng, true, band);
+    for (uint8_t o = 1; o < TEST_OCT_HI - TEST_OCT_LO; o++){
+        double slope = band[o] - band[o - 1]; // dB per octave, per bin
+        if(fabs(slope + 3) > fabs(worst + 3))
+            worst = slope;
+    }
+    snprintf(detail, sizeof(detail), "worst octave %+.2f dB, -3 +-%.1f", worst, TEST_PINK_DB);
+    check(fabs(worst + 3) <= TEST_PINK_DB, "pink -3 dB/octave", detail);
+}
+
+int main(void)
+{
+    test_prbs(7, 6, 0x70be57344f143040ULL);
+    test_prbs(15, 14, 0x0f00140030004000ULL);
+    test_prbs(23, 18, 0x07c03ff0007c0000ULL);
+    test_white();
+    test_pink();
+    printf("%d failed\n", gFail);
+    return gFail ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * \file        test_task.c
+ * \brief       Host test of the scheduler of dsg_task.c, in the virtual time of the mock HAL.
+ * \details     The due tasks are called by their wake time and not by their priority,
+ * the tasks of a pass get the same time and GPIO sample even if a task takes time or the
+ * inputs change meanwhile, a task whose budget does not fit before a task with more
+ * priority is deferred, but not for longer than TK_DEFER_MAX_US, and the report counts
+ * the passes. The process returns 0 when every check passes.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_hal.h"
+#include "hal_mock.h"
+#include "dsg_task.h"
+
+#define TEST_T0     1000000     // Virtual time of the start
+#define TEST_RUN_US 50          // Run time of a call of the tasks
+
+static int gFail;
+static sched_t gSched;
+static task_t gTask[3];
+static char gOrder[8];          // Names of the calls of a pass
+static uint8_t gCalls;
+static uint64_t gNow[3];
+static uint32_t gGpios[3];
+
+/**
+ * @brief Print a check and count it if it fails
+ */
+static void check(bool ok, const char *name, const char *detail)
+{
+    printf("%-4s %-28s %s\n", ok ? "ok" : "FAIL", name, detail);
+    if(!ok)
+        gFail++;
+}
+
+/**
+ * @brief Record the call, take TEST_RUN_US and change the inputs, then wait for
+ * tk_wake_at() again
+ */
+static uint8_t recordTask(task_t *t)
+{
+    uint8_t i = (uint8_t)(t - gTask);
+    gOrder[gCalls++] = t->name[0];
+    gNow[i] = t->now;
+    gGpios[i] = t->gpios;
+    hal_mock_set_time(hal_time_us() + TEST_RUN_US);
+    hal_mock_set_inputs(hal_gpio_get_all() + 1);
+    t->wake = UINT64_MAX;
+    return TK_YIELDED;
+}
+
+/**
+ * @brief Run one pass at a time
+ */
+static void pass(uint64_t at)
+{
+    gCalls = 0;
+    gOrder[0] = 0;
+    hal_mock_set_time(at);
+    tk_run(&gSched);
+    gOrder[gCalls] = 0;
+}
+
+static void test_order(void)
+{
+    char detail[96];
+    // Priority a, b, c, but b is due first and a last
+    tk_wake_at(&gTask[0], TEST_T0 + 300);
+    tk_wake_at(&gTask[1], TEST_T0 + 100);
+    tk_wake_at(&gTask[2], TEST_T0 + 200);
+    hal_mock_set_inputs(0x40);
+    pass(TEST_T0 + 400);
+    snprintf(detail, sizeof(detail), "calls %s, expected bca", gOrder);
+    check(gOrder[0] == 'b' && gOrder[1] == 'c' && gOrder[2] == 'a' && !gOrder[3], "earliest wake first", detail);
+
+    snprintf(detail, sizeof(detail), "now %llu %llu %llu", (unsigned long long)gNow[0],
+        (unsigned long long)gNow[1], (unsigned long long)gNow[2]);
+    check(gNow[0] == TEST_T0 + 400 && gNow[1] == gNow[0] && gNow[2] == gNow[0], "one time per pass", detail);
+    snprintf(detail, sizeof(detail), "gpios 0x%lx 0x%lx 0x%lx", (unsigned long)gGpios[0],
+        (unsigned long)gGpios[1], (unsigned long)gGpios[2]);
+    check(gGpios[0] == 0x40 && gGpios[1] == 0x40 && gGpios[2] == 0x40, "one GPIO sample per pass", detail);
+
+    pass(TEST_T0 + 1000);
+    snprintf(detail, sizeof(detail), "%u calls", gCalls);
+    check(!gCalls, "waiting tasks not called", detail);
+}
+
+static void test_defer(void)
+{
+    char detail[96];
+    uint64_t t = TEST_T0 + 10000;
+    // c (budget 100) is due, a (more priority) wakes 60 us later
+    tk_wake_at(&gTask[0], t + 60);
+    tk_wake_at(&gTask[2], t);
+    pass(t);
+    snprintf(detail, sizeof(detail), "calls '%s', defer %lu", gOrder, (unsigned long)gTask[2].defer);
+    check(!gCalls && gTask[2].defer == 1, "budget does not fit", detail);
+    check(gSched.next == t, "deferred task not slept", "");
+
+    pass(t + 60);
+    snprintf(detail, sizeof(detail), "calls %s, expected ca", gOrder);
+    check(gOrder[0] == 'c' && gOrder[1] == 'a' && !gOrder[2], "runs when the other is due", detail);
+
+    // a wakes again and again just after c, c runs anyway after TK_DEFER_MAX_US
+    t += 1000;
+    tk_wake_at(&gTask[2], t);
+    uint64_t ran = 0;
+    for (uint64_t at = t; at < t + 2*TK_DEFER_MAX_US && !ran; at += 1000){
+        tk_wake_at(&gTask[0], at + 60);
+        pass(at);
+        if(gCalls)
+            ran = at;
+    }
+    snprintf(detail, sizeof(detail), "ran after %llu us, max %lu", (unsigned long long)(ran - t), (unsigned long)TK_DEFER_MAX_US);
+    check(ran && ran - t >= TK_DEFER_MAX_US && ran - t < TK_DEFER_MAX_US + 1000, "max defer", detail);
+}
+
+int main(void)
+{
+    hal_mock_set_time(TEST_T0);
+    tk_init(&gSched);
+    tk_add(&gSched, &gTask[0], "a", recordTask, 10);
+    tk_add(&gSched, &gTask[1], "b", recordTask, 10);
+    tk_add(&gSched, &gTask[2], "c", recordTask, 100);
+
+    test_order();
+    test_defer();
+
+    uint32_t passes = gSched.passes;
+    tk_report(&gSched);
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%lu passes counted, %lu after the report", (unsigned long)passes, (unsigned long)gSched.passes);
+    check(passes > 0 && !gSched.passes, "loop passes", detail);
+
+    printf("%d failed\n", gFail);
+    return gFail ? 1 : 0;
+}
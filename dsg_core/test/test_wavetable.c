@@ -0,0 +1,188 @@
+/**
+ * \file        test_wavetable.c
+ * \brief       Host test of the interpolated wavetable of wavetable_ref.h.
+ * \details     wt_ref_next(): each code is the floor of the exact linear interpolation
+ * between two entries at the alpha of the phase, for every index and alpha of random
+ * tables, the last entry interpolates towards the guard entry and the phase wraps to the
+ * first one. wt_ref_step(): the step is freq*2^32/WT_FS truncated, one second of samples
+ * wraps the phase freq times (minus the truncation) and the frequency error is below
+ * 1 LSB of the step. wt_ref_build(): the guard entry is the first one.
+ * The process returns 0 when every check passes.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "dsg_signal.h"
+#include "dsg_dac.h"
+#include "wavetable_ref.h"
+
+#define TEST_TABLES     64      // Random tables of the interpolation check
+#define TEST_LOW_BITS   37      // Value of the discarded bits of the phase, they must not matter
+
+static int gFail;
+
+/**
+ * @brief Print a check and count it if it fails
+ */
+static void check(bool ok, const char *name, const char *detail)
+{
+    printf("%-4s %-28s %s\n", ok ? "ok" : "FAIL", name, detail);
+    if(!ok)
+        gFail++;
+}
+
+/**
+ * @brief Exact linear interpolation between idx and idx + 1, rounded down
+ */
+static int32_t exact(const uint16_t *table, uint32_t idx, uint32_t alpha)
+{
+    double v = table[idx] + ((double)table[idx + 1] - table[idx])*alpha/256.0;
+    return (int32_t)floor(v);
+}
+
+/**
+ * @brief Every index and alpha of random tables of 8 and 12 bit codes, with the
+ * discarded bits of the phase set. The phase after the call must be advanced by step.
+ */
+static void test_interp(void)
+{
+    static uint16_t table[WT_SIZE + 1];
+    char detail[96];
+    uint32_t bad = 0, stepBad = 0, n = 0;
+    srand(1);
+    for (uint32_t k = 0; k < TEST_TABLES; k++){
+        uint16_t max = k & 1 ? 4095 : 255;
+        for (uint32_t i = 0; i < WT_SIZE; i++)
+            table[i] = (uint16_t)(rand() % (max + 1));
+        table[WT_SIZE] = table[0];
+        for (uint32_t idx = 0; idx < WT_SIZE; idx++){
+            for (uint32_t alpha = 0; alpha < 256; alpha++){
+                uint32_t phase = (idx << (32 - WT_BITS)) | (alpha << WT_FRAC_SHIFT) | TEST_LOW_BITS;
+                uint32_t step = (uint32_t)rand();
+                uint32_t p = phase;
+                if(wt_ref_next(table, &p, step) != exact(table, idx, alpha))
+                    bad++;
+                if(p != phase + step)
+                    stepBad++;
+                n++;
+            }
+        }
+    }
+    snprintf(detail, sizeof(detail), "%lu of %lu codes differ", (unsigned long)bad, (unsigned long)n);
+    check(!bad, "linear interpolation", detail);
+    snprintf(detail, sizeof(detail), "%lu phases not advanced by step", (unsigned long)stepBad);
+    check(!stepBad, "phase advance", detail);
+}
+
+/**
+ * @brief The last entry interpolates towards the guard entry, and the phase that wraps
+ * past 2^32 continues from the first entry
+ */
+static void test_wrap(void)
+{
+    static uint16_t table[WT_SIZE + 1];
+    char detail[96];
+    for (uint32_t i = 0; i < WT_SIZE; i++)
+        table[i] = (uint16_t)(1000 + i);
+    table[0] = 100;
+    table[WT_SIZE] = table[0];
+
+    // Last entry 1255, guard 100: halfway is 677.5
+    uint32_t phase = ((WT_SIZE - 1) << (32 - WT_BITS)) | (128u << WT_FRAC_SHIFT);
+    uint32_t step = 1u << (32 - WT_BITS);           // One entry per sample
+    uint16_t last = wt_ref_next(table, &phase, step);
+    uint16_t first = wt_ref_next(table, &phase, step);
+    snprintf(detail, sizeof(detail), "%u, expected %ld", last, (long)exact(table, WT_SIZE - 1, 128));
+    check(last == exact(table, WT_SIZE - 1, 128) && last == 677, "guard entry", detail);
+    snprintf(detail, sizeof(detail), "%u, expected %ld", first, (long)exact(table, 0, 128));
+    check(first == exact(table, 0, 128), "wrap to the first entry", detail);
+
+    // Alpha 255 of the last entry, just before the wrap
+    phase = 0xFFFFFFFFu;
+    last = wt_ref_next(table, &phase, 1);
+    snprintf(detail, sizeof(detail), "%u, expected %ld, phase 0x%08lx", last,
+        (long)exact(table, WT_SIZE - 1, 255), (unsigned long)phase);
+    check(last == exact(table, WT_SIZE - 1, 255) && !phase, "end of the phase", detail);
+}
+
+/**
+ * @brief The step of some frequencies: truncation, wraps of the phase in one second of
+ * samples and frequency error
+ */
+static void test_step(void)
+{
+    static const uint32_t freqs[] = {1, 7, 50, 1000, 1234, 12345, WT_FS/4, WT_FS/2 - 1};
+    char detail[96];
+    for (uint32_t k = 0; k < sizeof(freqs)/sizeof(freqs[0]); k++){
+        uint32_t f = freqs[k];
+        uint32_t step = wt_ref_step(f);
+        uint64_t exactStep = ((uint64_t)f << 32)/WT_FS;
+        uint64_t rem = ((uint64_t)f << 32) % WT_FS;
+
+        uint32_t phase = 0, wraps = 0;
+        static uint16_t table[WT_SIZE + 1];
+        for (uint32_t i = 0; i < WT_FS; i++){
+            uint32_t prev = phase;
+            wt_ref_next(table, &phase, step);
+            if(phase < prev)
+                wraps++;
+        }
+        double err = (double)f - (double)step*WT_FS/4294967296.0;
+        char name[32];
+        snprintf(name, sizeof(name), "step %lu Hz", (unsigned long)f);
+        snprintf(detail, sizeof(detail), "step %lu, %lu wraps in 1 s, error %.6f Hz", (unsigned long)step,
+            (unsigned long)wraps, err);
+        check(step == exactStep && wraps == (rem ? f - 1 : f) &&
+            err >= 0 && err < (double)WT_FS/4294967296.0, name, detail);
+    }
+}
+
+/**
+ * @brief The table built from a signal ends with the guard entry and its codes are the
+ * ones of dac_codes()
+ */
+static void test_build(void)
+{
+    static uint16_t table[WT_SIZE + 1];
+    static uint16_t codes[WT_SIZE];
+    static int16_t values[WT_SIZE];
+    signal_t signal;
+    dac_t dac;
+    char detail[96];
+
+    dac_init(&dac, &dac_parallel8, 0, NULL, true);
+    signal_gen_init(&signal, 1000, 2000, 500, true);
+    signal_set_state(&signal, 1); // Triangle
+    signal.value = 1234;
+    wt_ref_build(table, NULL, &signal, &dac);
+    int16_t value = signal.value;
+    signal_values(&signal, values, WT_SIZE);
+    dac_codes(&dac, values, codes, NULL, WT_SIZE);
+
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < WT_SIZE; i++)
+        if(table[i] != codes[i])
+            bad++;
+    snprintf(detail, sizeof(detail), "%lu codes differ, guard %u first %u, value %d", (unsigned long)bad,
+        table[WT_SIZE], table[0], value);
+    check(!bad && table[WT_SIZE] == table[0] && value == 1234, "build", detail);
+}
+
+int main(void)
+{
+    test_interp();
+    test_wrap();
+    test_step();
+    test_build();
+
+    printf("%d failed\n", gFail);
+    return gFail ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * \file        wavetable_ref.h
+ * \brief       Reference implementation of the interpolated wavetable playback.
+ * \details     Plain C version of what the SIO interpolator computes in irq_c/wavetable.h.
+ * It does not depend on the Pico SDK, so it can be compiled on the host to check
+ * the output of the hardware sample by sample.
+ *
+ * Phase accumulator (32 bits):
+ *      | index (WT_BITS) | alpha (8) | discarded |
+ *
+ * The index selects two adjacent entries of the table and alpha is the fraction
+ * between them in 1/256 steps.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __WAVETABLE_REF_
+#define __WAVETABLE_REF_
+
+#include <stdint.h>
+
+#include "dsg_signal.h"
+#include "dsg_dac.h"
+
+#define WT_BITS         8                       // log2 of the number of entries of the table
+#define WT_SIZE         (1u << WT_BITS)         // Number of entries of the table
+#define WT_FRAC_SHIFT   (32 - WT_BITS - 8)      // Position of alpha in the phase accumulator
+#define WT_T_SAMPLE     10                      // Sample period in us of the interpolated mode
+#define WT_FS           (1000000/WT_T_SAMPLE)   // Sample rate in Hz of the interpolated mode
+
+/**
+ * @brief Phase increment per sample for a given frequency.
+ *
+ * @param freq in Hz
+ * @return uint32_t freq*2^32/WT_FS
+ */
+static inline uint32_t wt_ref_step(uint32_t freq)
+{
+    return (uint32_t)(((uint64_t)freq << 32)/WT_FS);
+}
+
+/**
+ * @brief Get the next code and advance the phase. Same arithmetic as the
+ * blend mode of the interpolator: base0 + ((base1 - base0)*alpha >> 8).
+ *
+ * @param table WT_SIZE + 1 codes, table[WT_SIZE] must be equal to table[0]
+ * @param phase Phase accumulator
+ * @param step  Phase increment
+ * @return uint16_t
+ */
+static inline uint16_t wt_ref_next(const uint16_t *table, uint32_t *phase, uint32_t step)
+{
+    uint32_t idx = *phase >> (32 - WT_BITS);
+    int32_t alpha = (int32_t)((*phase >> WT_FRAC_SHIFT) & 0xFF);
+    int32_t base0 = table[idx];
+    int32_t base1 = table[idx + 1];
+
+    *phase += step;
+    return (uint16_t)(base0 + (((base1 - base0)*alpha) >> 8));
+}
+
+/**
+ * @brief Fill a table with one period of the signal, converted to DAC codes, and its
+ * guard entry.
+ *
+ * @param table WT_SIZE + 1 codes
+ * @param q     WT_SIZE codes without the dither, for dac_redither(). NULL if they are not needed
+ * @param signal
+ * @param dac   Its calibration and requantization are used to convert the values
+ */
+static inline void wt_ref_build(uint16_t *table, uint32_t *q, signal_t *signal, const dac_t *dac)
+{
+    int16_t value = signal->value; // The signal functions overwrite it
+    int16_t values[WT_SIZE];
+
+    signal_values(signal, values, WT_SIZE); // Same points as signal_calculate(): t from 1 to WT_SIZE
+    dac_codes(dac, values, table, q, WT_SIZE);
+    table[WT_SIZE] = table[0]; // Guard entry for the interpolation of the last point
+    signal->value = value;
+}
+
+#endif // __WAVETABLE_REF_
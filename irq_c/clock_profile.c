@@ -0,0 +1,62 @@
+/**
+ * \file        clock_profile.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+
+#include "clock_profile.h"
+
+const clock_profile_t gClockProfiles[CLOCK_PROFILES] = {
+    {"48 MHz",  48000,  VREG_VOLTAGE_1_10},
+    {"125 MHz", 125000, VREG_VOLTAGE_1_10},     // Default of the SDK
+    {"200 MHz", 200000, VREG_VOLTAGE_1_15},
+    {"250 MHz", 250000, VREG_VOLTAGE_1_20},
+};
+
+static const clock_profile_t *gProfile = NULL;
+
+bool clock_profile_set(const clock_profile_t *profile)
+{
+    uint vco, postdiv1, postdiv2;
+    if(!check_sys_clock_khz(profile->sys_khz, &vco, &postdiv1, &postdiv2))
+        return false;
+
+    bool up = profile->sys_khz > clock_get_hz(clk_sys)/1000;
+    if(up){
+        vreg_set_voltage(profile->vreg);
+        sleep_ms(10); // The regulator must settle before the clock is raised
+    }
+    set_sys_clock_khz(profile->sys_khz, true);
+    if(!up){
+        vreg_set_voltage(profile->vreg);
+    }
+    gProfile = profile;
+    return true;
+}
+
+const clock_profile_t *clock_profile_get(void)
+{
+    return gProfile;
+}
+
+void clock_profile_report(void)
+{
+    printf("Profile: %s\n", gProfile ? gProfile->name : "none");
+    printf("clk_sys:  %lu kHz\n", (unsigned long)frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS));
+    printf("clk_peri: %lu kHz\n", (unsigned long)frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_PERI));
+    printf("clk_usb:  %lu kHz\n", (unsigned long)frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_USB));
+    printf("clk_adc:  %lu kHz\n", (unsigned long)frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_ADC));
+    printf("clk_ref:  %lu kHz\n", (unsigned long)frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_REF));
+}
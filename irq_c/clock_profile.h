@@ -0,0 +1,63 @@
+/**
+ * \file        clock_profile.h
+ * \brief       Profiles of the system clock and the core voltage.
+ * \details     set_sys_clock_khz() changes clk_sys and clk_peri, so everything that
+ * divides them must be recomputed after a change: the PWM PITs, the DMA timers and
+ * the SPI of the DAC backends. The PIO program of the frequency counter runs at clk_sys
+ * without divider and converts its counts with the clock of each measurement. The sample 
+ * periods are counted by the timer, which runs from clk_ref at 1 MHz, they do not change.
+ *
+ * The voltage is raised before a higher clock and lowered after a lower one.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __CLOCK_PROFILE_
+#define __CLOCK_PROFILE_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/vreg.h"
+
+#define CLOCK_PROFILES      4   // Number of profiles
+#define CLOCK_PROFILE_BOOT  1   // Profile set at startup: 125 MHz
+
+/**
+ * @typedef clock_profile_t
+ *
+ * @brief System clock and core voltage
+ *
+ */
+typedef struct{
+    const char *name;
+    uint32_t sys_khz;               // clk_sys in kHz, it must be generated exactly by the PLL
+    enum vreg_voltage vreg;         // Core voltage
+}clock_profile_t;
+
+extern const clock_profile_t gClockProfiles[CLOCK_PROFILES];
+
+/**
+ * @brief Set the system clock and the voltage of a profile. The dividers that 
+ * depend on clk_sys must be recomputed after it.
+ *
+ * @param profile
+ * @return false if the PLL can not generate the clock, nothing is changed
+ */
+bool clock_profile_set(const clock_profile_t *profile);
+
+/**
+ * @brief Profile set, NULL if none was set
+ *
+ * @return const clock_profile_t*
+ */
+const clock_profile_t *clock_profile_get(void);
+
+/**
+ * @brief Print the clocks measured with the frequency counter
+ *
+ */
+void clock_profile_report(void);
+
+#endif // __CLOCK_PROFILE_
@@ -0,0 +1,52 @@
+/**
+ * \file        command.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#include "command.h"
+
+
+void cmd_init(cmd_t *cmd)
+{
+    cmd->len = 0;
+    cmd->overflow = false;
+}
+
+bool cmd_poll(cmd_t *cmd, char **name, int32_t *value)
+{
+    int c;
+    while((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT){
+        if(c != '\r' && c != '\n'){
+            if(cmd->len < CMD_LEN - 1)
+                cmd->line[cmd->len++] = (char)c;
+            else
+                cmd->overflow = true;
+            continue;
+        }
+        // End of line
+        if(!cmd->len || cmd->overflow){
+            cmd_init(cmd);
+            continue;
+        }
+        cmd->line[cmd->len] = '\0';
+        cmd->len = 0;
+
+        char *sep = cmd->line;
+        while(*sep && *sep != ' ') sep++;
+        *value = *sep ? strtol(sep + 1, NULL, 10) : 0;
+        *sep = '\0';
+        *name = cmd->line;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,50 @@
+/**
+ * \file        command.h
+ * \brief       Command interface through the serial or USB terminal.
+ * \details     Each command is a line with a name and a value, e.g. "duty 250" or "cal_mv -4890".
+ * The characters are read without blocking, so it can be polled from the main loop.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __COMMAND_
+#define __COMMAND_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CMD_LEN     32      // Max length of a command line
+
+/**
+ * @typedef cmd_t
+ *
+ * @brief Structure to assemble the command lines
+ *
+ */
+typedef struct{
+    char line[CMD_LEN];     // Characters received of the current line
+    uint8_t len;            // Number of characters in line
+    bool overflow;          // The current line is too long, it will be discarded
+}cmd_t;
+
+/**
+ * @brief Initialize the command line
+ *
+ * @param cmd
+ */
+void cmd_init(cmd_t *cmd);
+
+/**
+ * @brief Read the available characters. When a line is completed, it is split in
+ * its name and its value.
+ *
+ * @param cmd
+ * @param name  Name of the command, points to cmd->line
+ * @param value Value of the command, 0 if it does not have one. It can be negative
+ * @return true when a command was received
+ */
+bool cmd_poll(cmd_t *cmd, char **name, int32_t *value);
+
+#endif // __COMMAND_
@@ -1,6 +1,6 @@
 /**
  * \file        dac.c
- * \brief
+ * \brief       DMA of the block writes of the backends
  * \details
  * \author      MST_CDA
  * \version     0.0.1
@@ -10,46 +10,55 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include "hardware/gpio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
 #include "dac.h"
 
 
-void dac_init(dac_t *dac, uint8_t gpio_lsb, bool en)
+void dac_dma_init(dac_dma_t *dma)
 {
-    dac->gpio_lsb = gpio_lsb;
-    dac->digit_v = 0;
-    dac->en = en;
+    dma->data = dma_claim_unused_channel(true);
+    dma->ctrl = dma_claim_unused_channel(true);
+    dma->timer = dma_claim_unused_timer(true);
+    dma->src = NULL;
+}
+
+bool dac_dma_set_rate(dac_dma_t *dma, uint32_t rate)
+{
+    uint32_t div = rate ? clock_get_hz(clk_sys)/rate : 0;
+    if(!div || div > 0xFFFF)
+        return false;
 
-    gpio_init_mask(0x000000FF << dac->gpio_lsb);
-    gpio_set_dir_masked(0x000000FF << dac->gpio_lsb, 0x000000FF << dac->gpio_lsb); // Set all gpios as outputs
+    dma_timer_set_fraction(dma->timer, 1, (uint16_t)div); // rate = clk_sys*1/div
+    return true;
 }
 
-void dac_calculate(dac_t *dac, int16_t decim_v)
+void dac_dma_start(dac_dma_t *dma, volatile void *dst, const uint16_t *src, uint16_t n, uint dreq, bool loop)
 {
-    dac->digit_v = (decim_v + (int16_t)DAC_BIAS + 5000)*RESOLUTION/DAC_RANGE ; // normalize to 8 bits
-    dac->BITS.bit0 = (dac->digit_v & 0x01) >> 0;
-    dac->BITS.bit1 = (dac->digit_v & 0x02) >> 1;
-    dac->BITS.bit2 = (dac->digit_v & 0x04) >> 2;
-    dac->BITS.bit3 = (dac->digit_v & 0x08) >> 3;
-    dac->BITS.bit4 = (dac->digit_v & 0x10) >> 4;
-    dac->BITS.bit5 = (dac->digit_v & 0x20) >> 5;
-    dac->BITS.bit6 = (dac->digit_v & 0x40) >> 6;
-    dac->BITS.bit7 = (dac->digit_v & 0x80) >> 7;
-
-    dac_output(dac);
+    dac_dma_stop(dma);
+    dma->src = src;
+
+    // Control channel: writes the address of the block in the read address trigger of the data channel
+    dma_channel_config cfg = dma_channel_get_default_config(dma->ctrl);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, false);
+    dma_channel_configure(dma->ctrl, &cfg, &dma_hw->ch[dma->data].al3_read_addr_trig, &dma->src, 1, false);
+
+    cfg = dma_channel_get_default_config(dma->data);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, dreq);
+    if(loop)
+        channel_config_set_chain_to(&cfg, dma->ctrl);
+    dma_channel_configure(dma->data, &cfg, dst, src, n, true);
 }
 
-void dac_output(dac_t *dac)
+void dac_dma_stop(dac_dma_t *dma)
 {
-    if(!dac->en) return;
-
-    gpio_put(dac->gpio_lsb + 0, dac->BITS.bit0);
-    gpio_put(dac->gpio_lsb + 1, dac->BITS.bit1);
-    gpio_put(dac->gpio_lsb + 2, dac->BITS.bit2);
-    gpio_put(dac->gpio_lsb + 3, dac->BITS.bit3);
-    gpio_put(dac->gpio_lsb + 4, dac->BITS.bit4);
-    gpio_put(dac->gpio_lsb + 5, dac->BITS.bit5);
-    gpio_put(dac->gpio_lsb + 6, dac->BITS.bit6);
-    gpio_put(dac->gpio_lsb + 7, dac->BITS.bit7);
-    
+    // The control channel first, so it does not restart the data channel
+    dma_channel_abort(dma->ctrl);
+    dma_channel_abort(dma->data);
+    dma_channel_abort(dma->ctrl);
 }
@@ -1,7 +1,10 @@
 /**
  * \file        dac.h
- * \brief
- * \details
+ * \brief       Backends of irq_c that are not in dsg_core, and the DMA of the block writes.
+ * \details     The DAC itself (dac_t, the conversion of the tables, the parallel backends)
+ * is dsg_dac.h of dsg_core. The backends of this variant use peripherals of the RP2040:
+ *      dac_mcp4922:    MCP4922, 12 bits by SPI. Two channels (see dac_spi.c)
+ *      dac_pwm:        PWM of one GPIO and an RC filter, 8 bits. One channel (see dac_pwm.c)
  * \author      MST_CDA
  * \version     0.0.1
  * \date        07/04/2024
@@ -12,57 +15,61 @@
 #define __DAC_
 
 #include <stdint.h>
-#include "hardware/timer.h"
+#include <stdbool.h>
+#include "hardware/dma.h"
 
-#define RESOLUTION  255         // 8 bits
-#define DAC_RANGE   10120        // 0 to 9.3V
-#define DAC_BIAS    -60         // DAC bias
+#include "dsg_dac.h"
+
+extern const dac_backend_t dac_mcp4922;
+extern const dac_backend_t dac_pwm;
 
 /**
- * @typedef dac_t 
+ * @typedef dac_dma_t
+ *
+ * @brief DMA channels of the block write of a backend. The control channel 
+ * reloads the read address of the data channel to output the block in a loop.
  *
- * @brief Structure to manage a 8-bit DAC
- * 
  */
 typedef struct{
-    struct {
-        uint8_t bit0     : 1;
-        uint8_t bit1     : 1;
-        uint8_t bit2     : 1;
-        uint8_t bit3     : 1;
-        uint8_t bit4     : 1;
-        uint8_t bit5     : 1;
-        uint8_t bit6     : 1;
-        uint8_t bit7     : 1;
-    }BITS;
-    bool en;                        ///< Enable DAC
-    uint8_t gpio_lsb;                ///< The LSB position of the GPIOs used to output the DAC signal
-    uint16_t digit_v;                 ///< Value to be outputed
-}dac_t;
+    int data;                       ///< Channel that writes the codes
+    int ctrl;                       ///< Channel that restarts the data channel
+    int timer;                      ///< DMA timer for the rates without a DREQ of the peripheral
+    const uint16_t *src;            ///< Block being output, read by the control channel
+}dac_dma_t;
+
+/**
+ * @brief Claim the channels and the timer of a block write
+ * 
+ * @param dma 
+ */
+void dac_dma_init(dac_dma_t *dma);
 
 /**
- * @brief Initialize a 8-bit DAC. A DAC0808 is used as reference. 
+ * @brief Start the output of a block of 16-bit codes to a register of a peripheral
  * 
- * @param dac 
- * @param pin_lsb   The LSB position of the GPIOs used to output the DAC signal
- * @param period    Period of the output signal
- * @param en        Enable DAC
+ * @param dma 
+ * @param dst   Register
+ * @param src   Codes
+ * @param n     Number of codes
+ * @param dreq  DREQ that paces the transfers
+ * @param loop  Output the block again and again
  */
-void dac_init(dac_t *dac, uint8_t gpio_lsb, bool en);
+void dac_dma_start(dac_dma_t *dma, volatile void *dst, const uint16_t *src, uint16_t n, uint dreq, bool loop);
 
 /**
- * @brief Generate BITS(8-bits) from the input value
+ * @brief Pace the transfers with the DMA timer at rate Hz.
  * 
- * @param dac 
- * @param decim_v 
+ * @param dma 
+ * @param rate 
+ * @return false if the rate can not be generated from clk_sys
  */
-void dac_calculate(dac_t *dac, int16_t decim_v);
+bool dac_dma_set_rate(dac_dma_t *dma, uint32_t rate);
 
 /**
- * @brief With BITS, output the signal.
+ * @brief Stop the output of the block
  * 
- * @param dac 
+ * @param dma 
  */
-void dac_output(dac_t *dac);
+void dac_dma_stop(dac_dma_t *dma);
 
-#endif // __DAC_
\ No newline at end of file
+#endif // __DAC_
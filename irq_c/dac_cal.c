@@ -0,0 +1,74 @@
+/**
+ * \file        dac_cal.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+
+#include "dac_cal.h"
+
+/**
+ * @typedef dac_cal_flash_t
+ *
+ * @brief Layout of the calibration in the flash
+ *
+ */
+typedef struct{
+    uint32_t magic;
+    int16_t mv[RESOLUTION + 1];
+    uint32_t sum;           // Sum of the entries, to detect a sector that was not completely programmed
+}dac_cal_flash_t;
+
+#define DAC_CAL_PAGES   ((sizeof(dac_cal_flash_t) + FLASH_PAGE_SIZE - 1)/FLASH_PAGE_SIZE)
+
+static uint32_t dac_cal_sum(const int16_t *mv)
+{
+    uint32_t sum = DAC_CAL_MAGIC;
+    for (uint16_t i = 0; i <= RESOLUTION; i++){
+        sum += (uint16_t)mv[i];
+    }
+    return sum;
+}
+
+bool dac_cal_load(dac_t *dac)
+{
+    const dac_cal_flash_t *flash = (const dac_cal_flash_t *)(XIP_BASE + DAC_CAL_OFFSET);
+    if(flash->magic != DAC_CAL_MAGIC || flash->sum != dac_cal_sum(flash->mv))
+        return false;
+
+    memcpy(dac->cal, flash->mv, sizeof(dac->cal));
+    return true;
+}
+
+void dac_cal_save(const dac_t *dac)
+{
+    static uint8_t page[DAC_CAL_PAGES*FLASH_PAGE_SIZE]; // flash_range_program() writes whole pages
+    dac_cal_flash_t *data = (dac_cal_flash_t *)page;
+
+    memset(page, 0xFF, sizeof(page));
+    data->magic = DAC_CAL_MAGIC;
+    memcpy(data->mv, dac->cal, sizeof(data->mv));
+    data->sum = dac_cal_sum(data->mv);
+
+    // The code can not run from the flash while it is written, on any of the cores
+    bool core1 = multicore_lockout_victim_is_initialized(1);
+    if(core1)
+        multicore_lockout_start_blocking();
+    uint32_t status = save_and_disable_interrupts();
+    flash_range_erase(DAC_CAL_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(DAC_CAL_OFFSET, page, sizeof(page));
+    restore_interrupts(status);
+    if(core1)
+        multicore_lockout_end_blocking();
+}
@@ -0,0 +1,53 @@
+/**
+ * \file        dac_cal.h
+ * \brief       Calibration of the DAC transfer: output in mV of each code.
+ * \details     The DAC0808 has INL/DNL errors and the LM358 has its own offset, so
+ * DAC_RANGE and DAC_BIAS are only a nominal transfer. Each board has a table of 256
+ * entries (dac_t.cal), the output at each 1/255 of the full scale of the backend, 
+ * stored in the last sector of the flash.
+ *
+ * Procedure (serial commands, see processCommands()):
+ *      cal_code <code>  Stop the generator and output <code> on both channels
+ *      cal_mv <mV>      Measured output of the current code
+ *      cal_save         Fit the table to the measured points, store it and restart the generator
+ *      cal_reset        Go back to the nominal transfer and erase the measured points
+ *
+ * The measured points and their fit are dsg_dac_cal.h of dsg_core, this file stores
+ * the table in the flash.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DAC_CAL_
+#define __DAC_CAL_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/flash.h"
+
+#include "dac.h"
+#include "dsg_dac_cal.h"
+
+#define DAC_CAL_MAGIC   0x4C414344                                  // "DCAL"
+#define DAC_CAL_OFFSET  (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE) // Last sector of the flash
+
+/**
+ * @brief Load the table of the board from the flash. If there is not a valid one,
+ * the nominal transfer is kept.
+ *
+ * @param dac
+ * @return true if the board is calibrated
+ */
+bool dac_cal_load(dac_t *dac);
+
+/**
+ * @brief Store the table in the flash. The interrupts are disabled while the 
+ * sector is erased and programmed.
+ *
+ * @param dac
+ */
+void dac_cal_save(const dac_t *dac);
+
+#endif // __DAC_CAL_
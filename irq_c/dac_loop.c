@@ -0,0 +1,91 @@
+/**
+ * \file        dac_loop.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "dac_loop.h"
+
+/**
+ * @brief Write the correction to the DAC
+ */
+static bool dac_loop_apply(dac_t *dac, float gain, float offset)
+{
+    int32_t g = (int32_t)lroundf(gain*DAC_CORR_ONE);
+    int16_t o = (int16_t)lroundf(offset);
+    if(g == dac->corr_gain && o == dac->corr_offset)
+        return false;
+    dac_set_correction(dac, g, o);
+    return true;
+}
+
+void dac_loop_init(dac_loop_t *loop)
+{
+    loop->en = false;
+    loop->gain = 1;
+    loop->offset = 0;
+    loop->err_amp = 0;
+    loop->err_offset = 0;
+    loop->updates = 0;
+    loop->converged = 0;
+}
+
+void dac_loop_enable(dac_loop_t *loop, dac_t *dac, bool en)
+{
+    if(!en){
+        dac_loop_init(loop);
+        dac_loop_apply(dac, 1, 0);
+    }
+    loop->en = en;
+}
+
+bool dac_loop_update(dac_loop_t *loop, dac_t *dac, const selftest_t *st)
+{
+    // A burst without crossings or without signal can not be used
+    if(!loop->en || st->freq <= 0 || st->ref_rms <= 0 || st->rms <= 0)
+        return false;
+
+    // Transfer of the output with the correction that was applied: out = G*(v*gain + offset) + O
+    float r = st->rms/st->ref_rms;
+    float g_out = r/loop->gain;
+    float o_out = st->mean - g_out*(st->ref_mean*loop->gain + loop->offset);
+
+    loop->err_amp = 100*(r - 1);
+    loop->err_offset = st->mean - st->ref_mean;
+    loop->updates++;
+    if(fabsf(loop->err_amp) < DAC_LOOP_TOL_AMP && fabsf(loop->err_offset) < DAC_LOOP_TOL_MV)
+        loop->converged++;
+    else
+        loop->converged = 0;
+
+    // Part of the way to the inverse of the transfer
+    float gain = loop->gain + DAC_LOOP_K*(1/g_out - loop->gain);
+    float offset = loop->offset + DAC_LOOP_K*(-o_out/g_out - loop->offset);
+    gain = fminf(fmaxf(gain, DAC_LOOP_GAIN_MIN), DAC_LOOP_GAIN_MAX);
+    offset = fminf(fmaxf(offset, -DAC_LOOP_OFFSET_MAX), DAC_LOOP_OFFSET_MAX);
+    if(fabsf(gain - loop->gain) < DAC_LOOP_STEP_GAIN && fabsf(offset - loop->offset) < DAC_LOOP_STEP_MV)
+        return false;
+
+    loop->gain = gain;
+    loop->offset = offset;
+    return dac_loop_apply(dac, gain, offset);
+}
+
+void dac_loop_report(const dac_loop_t *loop)
+{
+    if(!loop->en) return;
+
+    printf("Loop: gain %.4f, offset %+.1f mV, residual %+.2f %% %+.1f mV, %lu updates, %s\n",
+           loop->gain, loop->offset, loop->err_amp, loop->err_offset, (unsigned long)loop->updates,
+           loop->converged ? "converged" : "converging");
+}
@@ -0,0 +1,86 @@
+/**
+ * \file        dac_loop.h
+ * \brief       Closed loop of the amplitude and the offset, from the self-test bursts.
+ * \details     The output stage drifts with the temperature and the supply, its transfer is
+ * taken as out = G*v + O around 0 mV. Each DAC_LOOP_PERIOD_US a burst of the ADC (selftest.h)
+ * gives the rms and the mean of the output, G and O are estimated with the correction that was
+ * applied, and the correction (1/G, -O/G) is moved DAC_LOOP_K of the way to them.
+ *
+ * The correction is applied by dac_code() when the tables are built (dac_set_correction()),
+ * the signal ISR and the DMA only read codes. The tables are only built again when the
+ * correction changes more than DAC_LOOP_STEP_GAIN or DAC_LOOP_STEP_MV.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __DAC_LOOP_
+#define __DAC_LOOP_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dac.h"
+#include "selftest.h"
+
+#define DAC_LOOP_PERIOD_US  10000000    // Time between bursts
+#define DAC_LOOP_K          0.5f        // Fraction of the error corrected at each update
+#define DAC_LOOP_GAIN_MIN   0.8f        // Limits of the correction
+#define DAC_LOOP_GAIN_MAX   1.25f
+#define DAC_LOOP_OFFSET_MAX 500         // mV
+#define DAC_LOOP_STEP_GAIN  0.001f      // Min change that builds the tables again
+#define DAC_LOOP_STEP_MV    1.0f
+#define DAC_LOOP_TOL_AMP    1.0f        // Converged: residual of the amplitude below 1 %
+#define DAC_LOOP_TOL_MV     20.0f       // Converged: residual of the offset below 20 mV (half LSB)
+
+/**
+ * @typedef dac_loop_t
+ *
+ * @brief Structure to manage the closed loop and its telemetry
+ *
+ */
+typedef struct{
+    bool en;
+    float gain;             // Correction applied
+    float offset;           // Correction applied, in mV
+    float err_amp;          // Residual of the last burst: amplitude in %
+    float err_offset;       // Residual of the last burst: offset in mV
+    uint32_t updates;       // Bursts used
+    uint32_t converged;     // Bursts in a row within the tolerances, 0 if the last one was not
+}dac_loop_t;
+
+/**
+ * @brief Initialize the loop, disabled and without correction
+ *
+ * @param loop
+ */
+void dac_loop_init(dac_loop_t *loop);
+
+/**
+ * @brief Enable or disable the loop. Disabled, the correction is removed from the DAC.
+ *
+ * @param loop
+ * @param dac
+ * @param en
+ */
+void dac_loop_enable(dac_loop_t *loop, dac_t *dac, bool en);
+
+/**
+ * @brief Update the correction with the result of a burst
+ *
+ * @param loop
+ * @param dac
+ * @param st
+ * @return true if the correction changed and the tables must be built again
+ */
+bool dac_loop_update(dac_loop_t *loop, dac_t *dac, const selftest_t *st);
+
+/**
+ * @brief Print the correction, the residual error and the convergence
+ *
+ * @param loop
+ */
+void dac_loop_report(const dac_loop_t *loop);
+
+#endif // __DAC_LOOP_
@@ -0,0 +1,97 @@
+/**
+ * \file        dac_pwm.c
+ * \brief       Backend of a PWM output filtered by an RC: one GPIO, no DAC.
+ * \details     The slice of gpio_lsb runs from clk_sys without divider and wraps 
+ * at 2^DAC_PWM_BITS - 1, so the carrier is clk_sys/256 (488 kHz at 125 MHz), far 
+ * above the band of the signal. The code is the level of the channel: the duty cycle.
+ *
+ * write_block() writes the codes by DMA into the CC register of the slice. At the 
+ * rate of the carrier, the transfers are paced by the DREQ of the wrap of the slice; 
+ * at lower rates, by a DMA timer: CC is double buffered and only loaded at the wrap, 
+ * so the duty cycle changes at the end of a period of the carrier anyway.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+#include "dac.h"
+
+#define DAC_PWM_BITS    8
+
+static dac_dma_t dac_pwm_dma;  // DMA of write_block()
+
+static void dac_pwm_init(dac_t *dac, const uint8_t pins_b[8])
+{
+    uint slice = pwm_gpio_to_slice_num(dac->gpio_lsb);
+
+    pwm_config cfg = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&cfg, 1);
+    pwm_config_set_wrap(&cfg, (1u << DAC_PWM_BITS) - 1);
+    pwm_init(slice, &cfg, true);
+    gpio_set_function(dac->gpio_lsb, GPIO_FUNC_PWM);
+    dac->mask = 1UL << dac->gpio_lsb;
+
+    dac_dma_init(&dac_pwm_dma);
+}
+
+static void dac_pwm_write(dac_t *dac, uint16_t code_a, uint16_t code_b)
+{
+    pwm_set_gpio_level(dac->gpio_lsb, code_a);
+}
+
+static uint32_t dac_pwm_max_rate(const dac_t *dac)
+{
+    return clock_get_hz(clk_sys) >> DAC_PWM_BITS; // One code per period of the carrier
+}
+
+static bool dac_pwm_write_block(dac_t *dac, const uint16_t *codes_a, const uint16_t *codes_b, uint16_t start_b,
+                                uint16_t n, uint32_t rate, bool loop)
+{
+    uint slice = pwm_gpio_to_slice_num(dac->gpio_lsb);
+    uint dreq;
+
+    if(rate > dac_pwm_max_rate(dac))
+        return false;
+    if(rate == dac_pwm_max_rate(dac)){
+        dreq = pwm_get_dreq(slice);
+    }
+    else{
+        dac_dma_stop(&dac_pwm_dma); // The timer is going to change
+        if(!dac_dma_set_rate(&dac_pwm_dma, rate))
+            return false;
+        dreq = dma_get_timer_dreq(dac_pwm_dma.timer);
+    }
+
+    // A 16-bit write is replicated in both halves of the register, the channels A and B
+    dac_dma_start(&dac_pwm_dma, &pwm_hw->slice[slice].cc, codes_a, n, dreq, loop);
+    return true;
+}
+
+static void dac_pwm_stop_block(dac_t *dac)
+{
+    dac_dma_stop(&dac_pwm_dma);
+}
+
+const dac_backend_t dac_pwm = {
+    .name = "PWM",
+    .bits = DAC_PWM_BITS,
+    .channels = 1,
+    .sync = false,
+    .block_channels = 1,
+    .init = dac_pwm_init,
+    .write = dac_pwm_write,
+    .write_block = dac_pwm_write_block,
+    .stop_block = dac_pwm_stop_block,
+    .max_rate = dac_pwm_max_rate,
+    .clk_update = NULL,
+};
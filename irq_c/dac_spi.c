@@ -0,0 +1,104 @@
+/**
+ * \file        dac_spi.c
+ * \brief       Backend of the MCP4922: dual 12-bit DAC with SPI interface.
+ * \details     SPI1 at DAC_SPI_BAUD, 16-bit frames. The CS of the SPI is toggled by the
+ * hardware between frames and LDAC is tied to GND, so each channel is updated at the end
+ * of its frame: the channel B changes one frame (about 1 us) after the channel A.
+ *
+ *      | A/B | BUF | GA | SHDN | D11 ... D0 |
+ *
+ * The signal ISR writes both frames in the FIFO of the SPI, it does not wait for them.
+ * write_block() sends the frames of both channels by DMA, interleaved A, B, A... and paced
+ * by a DMA timer at twice the rate: the channel B changes half a sample after the channel A.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/gpio.h"
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+
+#include "dac.h"
+
+#define DAC_SPI         spi1
+#define DAC_SPI_BAUD    20000000    // Max of the MCP4922
+#define DAC_SPI_SCK     10
+#define DAC_SPI_TX      11
+#define DAC_SPI_CS      13
+#define DAC_SPI_CMD_A   0x3000      // Channel A, unbuffered, gain 1x, active
+#define DAC_SPI_CMD_B   0xB000      // Channel B, unbuffered, gain 1x, active
+#define DAC_SPI_BLOCK   256         // Max codes per channel of write_block()
+
+static uint16_t dac_spi_block[2*DAC_SPI_BLOCK]; // Frames sent by DMA, A and B
+static dac_dma_t dac_spi_dma;                   // DMA of write_block()
+
+static void dac_spi_init(dac_t *dac, const uint8_t pins_b[8])
+{
+    spi_init(DAC_SPI, DAC_SPI_BAUD);
+    spi_set_format(DAC_SPI, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    gpio_set_function(DAC_SPI_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(DAC_SPI_TX, GPIO_FUNC_SPI);
+    gpio_set_function(DAC_SPI_CS, GPIO_FUNC_SPI);
+
+    dac_dma_init(&dac_spi_dma);
+}
+
+static void dac_spi_write(dac_t *dac, uint16_t code_a, uint16_t code_b)
+{
+    spi_hw_t *hw = spi_get_hw(DAC_SPI);
+    hw->dr = DAC_SPI_CMD_A | code_a;
+    hw->dr = DAC_SPI_CMD_B | code_b;
+}
+
+static uint32_t dac_spi_max_rate(const dac_t *dac)
+{
+    // Two frames of 16 bits per sample, plus the time of CS between them
+    uint32_t rate = spi_get_baudrate(DAC_SPI)/(2*(16 + 2));
+    return rate < 1000000 ? rate : 1000000; // t_sample of the signal ISR is in us
+}
+
+static bool dac_spi_write_block(dac_t *dac, const uint16_t *codes_a, const uint16_t *codes_b, uint16_t start_b,
+                                uint16_t n, uint32_t rate, bool loop)
+{
+    if(!n || n > DAC_SPI_BLOCK || rate > dac_spi_max_rate(dac))
+        return false;
+
+    dac_dma_stop(&dac_spi_dma); // The frames are going to be overwritten
+    if(!dac_dma_set_rate(&dac_spi_dma, 2*rate)) // One frame per transfer
+        return false;
+    for (uint16_t i = 0, j = start_b%n; i < n; i++, j = (j + 1)%n){
+        dac_spi_block[2*i] = DAC_SPI_CMD_A | codes_a[i];
+        dac_spi_block[2*i + 1] = DAC_SPI_CMD_B | codes_b[j];
+    }
+    dac_dma_start(&dac_spi_dma, &spi_get_hw(DAC_SPI)->dr, dac_spi_block, 2*n, dma_get_timer_dreq(dac_spi_dma.timer), loop);
+    return true;
+}
+
+static void dac_spi_stop_block(dac_t *dac)
+{
+    dac_dma_stop(&dac_spi_dma);
+}
+
+static void dac_spi_clk_update(dac_t *dac)
+{
+    spi_set_baudrate(DAC_SPI, DAC_SPI_BAUD); // The divider of clk_peri
+}
+
+const dac_backend_t dac_mcp4922 = {
+    .name = "MCP4922",
+    .bits = 12,
+    .channels = 2,
+    .sync = false,
+    .block_channels = 2,
+    .init = dac_spi_init,
+    .write = dac_spi_write,
+    .write_block = dac_spi_write_block,
+    .stop_block = dac_spi_stop_block,
+    .max_rate = dac_spi_max_rate,
+    .clk_update = dac_spi_clk_update,
+};
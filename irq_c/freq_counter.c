@@ -0,0 +1,88 @@
+/**
+ * \file        freq_counter.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/time.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+#include "freq_counter.h"
+#include "freq_counter.pio.h"
+
+/**
+ * @brief Start the program again with K periods per measurement
+ */
+static void fc_restart(freq_counter_t *fc, uint32_t k)
+{
+    pio_sm_set_enabled(fc->pio, fc->sm, false);
+    pio_sm_clear_fifos(fc->pio, fc->sm);
+    pio_sm_restart(fc->pio, fc->sm);
+    pio_sm_exec(fc->pio, fc->sm, pio_encode_jmp(fc->offset)); // Back to the pull of K
+    pio_sm_put(fc->pio, fc->sm, k - 1);
+    fc->k = k;
+    pio_sm_set_enabled(fc->pio, fc->sm, true);
+}
+
+void fc_init(freq_counter_t *fc, uint8_t gpio)
+{
+    fc->pio = pio0;
+    fc->sm = pio_claim_unused_sm(fc->pio, true);
+    fc->offset = pio_add_program(fc->pio, &freq_counter_program);
+    fc_set_gpio(fc, gpio);
+}
+
+void fc_set_gpio(freq_counter_t *fc, uint8_t gpio)
+{
+    fc->gpio = gpio;
+    fc->freq = 0;
+    fc->t_last = time_us_32();
+
+    // The input is only read: no pio_gpio_init(), the pin keeps its function
+    pio_sm_set_enabled(fc->pio, fc->sm, false);
+    pio_sm_config cfg = freq_counter_program_get_default_config(fc->offset);
+    sm_config_set_in_pins(&cfg, gpio);  // wait pin
+    sm_config_set_jmp_pin(&cfg, gpio);  // jmp pin
+    sm_config_set_clkdiv(&cfg, 1);      // Counts clk_sys
+    pio_sm_init(fc->pio, fc->sm, fc->offset, &cfg);
+    fc_restart(fc, 1);
+}
+
+void fc_poll(freq_counter_t *fc)
+{
+    uint32_t now = time_us_32();
+    bool got = false;
+
+    while(!pio_sm_is_rx_fifo_empty(fc->pio, fc->sm)){
+        uint32_t n = pio_sm_get(fc->pio, fc->sm);
+        float cycles = 2.0f*((float)n + 2.0f*fc->k);
+        fc->freq = (float)fc->k*clock_get_hz(clk_sys)/cycles;
+        fc->t_last = now;
+        got = true;
+    }
+
+    if(got){
+        // K periods in FC_GATE_US, changed only when it is off by more than 2 times
+        float kf = fc->freq*FC_GATE_US/1000000;
+        uint32_t k = kf < 1 ? 1 : (kf > FC_K_MAX ? FC_K_MAX : (uint32_t)kf);
+        if(k > 2*fc->k || 2*k < fc->k){
+            fc_restart(fc, k);
+        }
+    }
+    else if(now - fc->t_last > FC_TIMEOUT_US){
+        // No edges, or a K too high for a lower frequency: one period again
+        fc->freq = 0;
+        fc->t_last = now;
+        if(fc->k > 1){
+            fc_restart(fc, 1);
+        }
+    }
+}
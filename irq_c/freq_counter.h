@@ -0,0 +1,84 @@
+/**
+ * \file        freq_counter.h
+ * \brief       Frequency counter of the output, on a PIO state machine.
+ * \details     The state machine counts the clk_sys cycles of K periods of the input
+ * (freq_counter.pio), with a resolution of 2 cycles (16 ns at 125 MHz), without the CPU and
+ * without interrupts. K is chosen from the last measurement so that each one lasts about
+ * FC_GATE_US: a single period below 1/FC_GATE_US Hz (reciprocal counting) and many periods
+ * above it, which is a gate of FC_GATE_US where the count is of whole periods.
+ *
+ * There is no spare GPIO on the board. With the sync output enabled, the input is its GPIO,
+ * high on the first point of each period. Otherwise it is FC_GPIO, the MSB of the channel A of
+ * the parallel backends: the PIO reads it while the SIO drives it, and it toggles once per
+ * period only when the signal crosses the middle of the range of the DAC. On a board with a
+ * comparator of the analog output, FC_GPIO is its pin.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __FREQ_COUNTER_
+#define __FREQ_COUNTER_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+
+#define FC_GPIO         17          // MSB of the channel A of the parallel backends
+#define FC_GATE_US      100000      // Target time of a measurement
+#define FC_TIMEOUT_US   3000000     // Without a measurement, the input has no edges: 2 periods at 1 Hz and the margin
+#define FC_K_MAX        100000      // Max periods of a measurement
+
+/**
+ * @typedef freq_counter_t
+ *
+ * @brief Structure to manage the frequency counter
+ *
+ */
+typedef struct{
+    PIO pio;
+    uint sm;
+    uint offset;            // Of the program in the PIO
+    uint8_t gpio;
+    uint32_t k;             // Periods of a measurement
+    uint32_t t_last;        // Time of the last measurement, in us
+    float freq;             // Hz, 0 if there are no edges
+}freq_counter_t;
+
+/**
+ * @brief Load the program in a free state machine of the pio0 and start counting
+ *
+ * @param fc
+ * @param gpio Input, its function is not changed
+ */
+void fc_init(freq_counter_t *fc, uint8_t gpio);
+
+/**
+ * @brief Measure another input. The measurement starts again from one period.
+ *
+ * @param fc
+ * @param gpio Input, its function is not changed
+ */
+void fc_set_gpio(freq_counter_t *fc, uint8_t gpio);
+
+/**
+ * @brief Read the measurements of the state machine, and change K when the frequency
+ * changes. It is called from the main loop.
+ *
+ * @param fc
+ */
+void fc_poll(freq_counter_t *fc);
+
+/**
+ * @brief Last frequency measured
+ *
+ * @param fc
+ * @return Hz, 0 if there were no edges in FC_TIMEOUT_US
+ */
+static inline float fc_freq(const freq_counter_t *fc)
+{
+    return fc->freq;
+}
+
+#endif // __FREQ_COUNTER_
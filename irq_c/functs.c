@@ -12,115 +12,590 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "pico/cyw43_arch.h"
 #include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
 #include "pico/time.h"
 #include "hardware/timer.h"
-#include "hardware/pwm.h"
 #include "hardware/irq.h"
 #include "hardware/gpio.h"
 #include "hardware/sync.h"
+#include "hardware/clocks.h"
 
 #include "functs.h"
-#include "keypad_irq.h"
+#include "dsg_keypad.h"
 #include "gpio_led.h"
-#include "gpio_button_irq.h"
-#include "signal_generator_irq.h"
+#include "dsg_button.h"
+#include "dsg_signal.h"
 #include "dac.h"
+#include "dac_cal.h"
 #include "gpio_led.h"
+#include "wavetable.h"
+#include "dsg_noise_buf.h"
+#include "command.h"
+#include "clock_profile.h"
+#include "timer_service.h"
+#include "power.h"
+#include "selftest.h"
+#include "dac_loop.h"
+#include "freq_counter.h"
+#include "preset.h"
 
 key_pad_t gKeyPad;
-signal_t gSignal;
+signal_t gSignal;       // Channel A
+signal_t gSignalB;      // Channel B, same sample clock as the channel A
+signal_t *gEdit = &gSignal; // Channel whose parameters are entered with the keypad and button
 gpio_button_t gButton;
 dac_t gDac;
+dac_cal_t gCal;
+wavetable_t gWave;
+wavetable_t gWaveB;
+noise_t gNoise;
+cmd_t gCmd;
+selftest_t gTest;
+dac_loop_t gLoop;
+volatile bool gLoopDue;     // A burst of the closed loop is due
+bool gLoopBurst;            // The burst running is the one of the closed loop
+freq_counter_t gCounter;
+bool gCounterValid;         // The input of gCounter toggles once per period of the channel A
+uint8_t gMarks[(SAMPLE + 7)/8];  // Markers of the sync output, one bit per point of the channel A
+uint32_t gArrayQ[SAMPLE];   // Codes of gSignal.arrayC without the dither (requant 1)
+uint32_t gArrayQB[SAMPLE];
+uint32_t gDitherUs;         // Time of the last dither of the tables
+volatile bool gRebuild;     // The keypad or the button changed the signal, the main loop builds the tables
 uint8_t gLed = 18;
+const uint8_t gDacBPins[8] = {19, 20, 21, 22, 26, 27, 28, 1}; // GPIOs of the channel B, from LSB to MSB
+ts_timer_t gSeqTimer;       // Row sequence of the keypad
+ts_timer_t gKpDbncTimer;    // Keypad debouncer
+ts_timer_t gBtnDbncTimer;   // Button debouncer
+ts_timer_t gLoopTimer;      // Bursts of the closed loop
+const dac_backend_t *gDacBackend = &dac_parallel8; // &dac_parallel12, &dac_mcp4922 or &dac_pwm on the boards with those outputs
 
 
 void initGlobalVariables(void)
 {
     kp_init(&gKeyPad,2,6,true);
+    kp_set_irq_callback(&gKeyPad, gpioCallback);
     signal_gen_init(&gSignal, 10, 1000, 500, true);
-    signal_calculate(&gSignal);
-    button_init(&gButton, 0);
-    dac_init(&gDac, 10, true);
+    signal_gen_init(&gSignalB, 10, 1000, 500, true);
+    signal_set_phase(&gSignalB, 90);
+    wt_init(&gWave, interp0, gSignal.freq);
+    wt_init(&gWaveB, NULL, gSignal.freq); // interp1 has no blend mode
+    noise_init(&gNoise, time_us_32(), 7);
+    cmd_init(&gCmd);
+    dac_init(&gDac, gDacBackend, 10, gDacBPins, true);
+    fc_init(&gCounter, FC_GPIO); // Before the tables, startSignal() selects its input
+    printf("DAC: %s, %d bits, max %lu Hz\n", gDac.backend->name, gDac.backend->bits, (unsigned long)gDac.backend->max_rate(&gDac));
+    dac_cal_init(&gCal);
+    if(!dac_cal_load(&gDac)){ // The tables are built with the calibration, it must be loaded before
+        printf("DAC not calibrated, nominal transfer\n");
+    }
+    int8_t slot = preset_last(); // Resume the last preset saved, its tables are already built
+    if(slot < 0 || !recallPreset(slot)){
+        updateSignal();
+    }
+    button_init(&gButton, 0, true);
+    button_set_irq_callback(&gButton, gpioCallback);
     led_init(gLed);
+    pw_init((0x0000000Fu << gKeyPad.KEY.clsb) | (1u << gButton.KEY.gpio_num)); // Keypad columns and button
+    st_init(&gTest);
+    dac_loop_init(&gLoop);
 }
 
-void initPWMasPIT(uint8_t slice, uint16_t milis, bool enable)
+void updateSignal(void)
 {
-    assert(milis<=262);                  // PWM can manage interrupt periods greater than 262 milis
-    float prescaler = (float)SYS_CLK_KHZ/500;
-    assert(prescaler<256); // the integer part of the clock divider can be greater than 255 
-                 // ||   counter frecuency    ||| Period in seconds taking into account de phase correct mode |||   
-    uint32_t wrap = (1000*SYS_CLK_KHZ*milis/(prescaler*2*1000)); // 500000*milis/2000
-    assert(wrap<((1UL<<17)-1));
-    // Configuring the PWM
-    pwm_config cfg =  pwm_get_default_config();
-    pwm_config_set_phase_correct(&cfg, true);
-    pwm_config_set_clkdiv(&cfg, prescaler);
-    pwm_config_set_clkdiv_mode(&cfg, PWM_DIV_FREE_RUNNING);
-    pwm_config_set_wrap(&cfg, wrap);
-    pwm_set_irq_enabled(slice, true);
-    irq_set_enabled(PWM_IRQ_WRAP, true);
-    pwm_init(slice, &cfg, enable);
- }
+    // The channel B follows the frequency and the playback mode of the channel A
+    signal_set_freq(&gSignalB, gSignal.freq);
+    gSignalB.STATE.interp = gSignal.STATE.interp;
+
+    // The sample rate of the SAMPLE points mode can not be higher than the one of the backend
+    uint32_t t_min = (S_TO_US + gDac.backend->max_rate(&gDac) - 1)/gDac.backend->max_rate(&gDac);
+    if(gSignal.t_sample < t_min){
+        gSignal.t_sample = t_min;
+        gSignalB.t_sample = t_min;
+    }
 
- void pwmIRQ(void)
- {
-    uint32_t cols;
-    bool button;
-    switch (pwm_get_irq_status_mask())
-    {
-    case 0x01UL: // PWM slice 0 ISR used as a PIT to generate row sequence
-        kp_gen_seq(&gKeyPad);
-        pwm_clear_irq(0);         // Acknowledge slice 0 PWM IRQ
-        break;
-
-    case 0x02UL: // PWM slice 1 ISR used as a PIT to implement the keypad debouncer
-        cols = gpio_get_all() & 0x000003C0; // Get columns gpio values
-        if(kp_is_2nd_zero(&gKeyPad)){
-            if(!cols){
-                kp_set_irq_enabled(&gKeyPad, true); // Enable the GPIO IRQs
-                pwm_set_enabled(0, true);    // Enable the row sequence
-                pwm_set_enabled(1, false);   // Disable the keypad debouncer
-                gKeyPad.KEY.dbnc = 0;
-            }
-            else
-                kp_clr_zflag(&gKeyPad);
+    // The DMA reads arrayC in a loop: it is stopped while the table is rewritten and the output
+    // holds the last code. STATE.dma stays set, so the ISR does not output it either
+    if(gSignal.STATE.dma){
+        gDac.backend->stop_block(&gDac);
+    }
+
+    signal_calculate(&gSignal);
+    signal_calculate(&gSignalB);
+    dac_codes(&gDac, gSignal.arrayV, gSignal.arrayC, gArrayQ, SAMPLE);
+    dac_codes(&gDac, gSignalB.arrayV, gSignalB.arrayC, gArrayQB, SAMPLE);
+    if(gDac.sync_mask){
+        // Sync output: the first point and the markers, written with their codes
+        for (uint8_t i = 0; i < SAMPLE; i++){
+            if(!i || gMarks[i/8] & (1 << i%8))
+                gSignal.arrayC[i] |= DAC_MARK;
         }
-        else{
-            if(!cols)
-                kp_set_zflag(&gKeyPad);
+    }
+    if(gSignal.STATE.interp && !signal_is_noise(&gSignal)){
+        wt_build(&gWave, &gSignal, &gDac);
+    }
+    if(gSignalB.STATE.interp){
+        wt_build(&gWaveB, &gSignalB, &gDac);
+    }
+    startSignal();
+}
+
+void startSignal(void)
+{
+    uint32_t t_min = (S_TO_US + gDac.backend->max_rate(&gDac) - 1)/gDac.backend->max_rate(&gDac);
+
+    wt_set_freq(&gWave, gSignal.freq);
+    wt_set_freq(&gWaveB, gSignal.freq);
+    if(signal_is_noise(&gSignal)){
+        noise_restart(&gNoise, &gSignal, &gDac);
+    }
+
+    // Lock the channel B to the channel A plus its phase
+    uint32_t status = save_and_disable_interrupts();
+    gSignalB.cnt = (gSignal.cnt + (uint32_t)gSignalB.phase*SAMPLE/360)%SAMPLE;
+    wt_sync(&gWaveB, &gWave, gSignalB.phase);
+    restore_interrupts(status);
+
+    // The backends whose DMA outputs all their channels play the SAMPLE points tables in a
+    // loop, the signal ISR does not write them
+    bool dma = gDac.backend->write_block && gDac.backend->block_channels == gDac.backend->channels
+               && gSignal.STATE.en && !gSignal.STATE.interp && !signal_is_noise(&gSignal);
+    if(dma){
+        // At the limit, the max rate of the backend, paced by its own hardware
+        uint32_t rate = gSignal.t_sample > t_min ? S_TO_US/gSignal.t_sample : gDac.backend->max_rate(&gDac);
+        dma = gDac.backend->write_block(&gDac, gSignal.arrayC, gSignalB.arrayC, (uint32_t)gSignalB.phase*SAMPLE/360,
+                                        SAMPLE, rate, true);
+    }
+    else if(gSignal.STATE.dma){
+        gDac.backend->stop_block(&gDac);
+    }
+    gSignal.STATE.dma = dma;
+    updateCounter();
+}
+
+void updateCounter(void)
+{
+    // The sync output is high on the first point of each period
+    uint8_t gpio = gDac.sync_mask ? gDac.sync_gpio : FC_GPIO;
+    bool valid = gSignal.STATE.en && !signal_is_noise(&gSignal);
+
+    if(gDac.sync_mask && !gSignal.STATE.interp){
+        // The markers add pulses to the period
+        for (uint8_t i = 0; i < sizeof(gMarks); i++){
+            valid = valid && !gMarks[i];
+        }
+    }
+    else if(!gDac.sync_mask){
+        // The MSB of the channel A toggles only if it is driven and the codes cross the middle
+        uint16_t half = (uint16_t)((dac_code_max(&gDac) + 1)/2), lo = UINT16_MAX, hi = 0;
+        for (uint8_t i = 0; i < SAMPLE; i++){
+            uint16_t code = gSignal.arrayC[i] & dac_code_max(&gDac);
+            lo = code < lo ? code : lo;
+            hi = code > hi ? code : hi;
         }
+        valid = valid && (gDac.mask & (1UL << FC_GPIO)) && lo < half && hi >= half;
+    }
+    if(gpio != gCounter.gpio){
+        fc_set_gpio(&gCounter, gpio);
+    }
+    gCounterValid = valid;
+}
 
-        pwm_clear_irq(1); // Acknowledge slice 1 PWM IRQ
-        break;
-
-    case 0x04UL: // PWM slice 2 ISR used as a PIT to implement the button debouncer
-        button = gpio_get(gButton.KEY.gpio_num);
-        if(button_is_2nd_zero(&gButton)){
-            if(!button){
-                signal_set_state(&gSignal, (gSignal.STATE.ss + 1)%4);
-                button_set_irq_enabled(&gButton, true); // Enable the GPIO IRQs
-                pwm_set_enabled(2, false);    // Disable the button debouncer
-                signal_calculate(&gSignal); // Recalculate the signal values
-                gButton.KEY.dbnc = 0;
-            }
-            else
-                button_clr_zflag(&gButton);
+void refillBuffers(void)
+{
+    if(signal_is_noise(&gSignal)){
+        noise_fill(&gNoise, &gSignal, &gDac);
+    }
+
+    // TPDF: a new dither once per period, so its error does not repeat with the signal
+    uint32_t now = time_us_32();
+    uint32_t period = gSignal.STATE.interp ? S_TO_US/gSignal.freq : (uint32_t)SAMPLE*gSignal.t_sample;
+    if(gDac.requant == DAC_REQ_TPDF && now - gDitherUs >= period){
+        gDitherUs = now;
+        if(gSignal.STATE.interp){
+            if(!signal_is_noise(&gSignal))
+                wt_redither(&gWave, &gDac);
+            wt_redither(&gWaveB, &gDac);
         }
         else{
-            if(!button)
-                button_set_zflag(&gButton);
+            if(!signal_is_noise(&gSignal))
+                dac_redither(&gDac, gArrayQ, gSignal.arrayC, SAMPLE);
+            dac_redither(&gDac, gArrayQB, gSignalB.arrayC, SAMPLE);
         }
-        pwm_clear_irq(2); // Acknowledge slice 2 PWM IRQ
-        break;
+    }
+}
 
-    default:
-        printf("Happend what should not happens on PWM IRQ\n");
-        break;
+void processCommands(void)
+{
+    char *name;
+    int32_t svalue;
+    if(!cmd_poll(&gCmd, &name, &svalue)) return;
+    uint32_t value = (uint32_t)svalue; // Only the measured mV of the calibration can be negative
+
+    // Same limits as the keypad
+    bool ok = true;
+    bool build = true; // The tables are built again after the command
+    if(!strncmp(name, "cal_", 4)){
+        ok = processCalibration(name + 4, svalue);
     }
- }
+    else if(!strcmp(name, "ch") && value <= 1){
+        gEdit = value ? &gSignalB : &gSignal;
+    }
+    else if(!strcmp(name, "wave") && value < (gEdit == &gSignal ? SIGNAL_STATES : SIGNAL_PERIODIC)){
+        signal_set_state(gEdit, value);
+    }
+    else if(!strcmp(name, "amp") && checkAmp(value)){
+        signal_set_amp(gEdit, value);
+    }
+    else if(!strcmp(name, "offset") && checkOffset(value)){
+        signal_set_offset(gEdit, value);
+    }
+    else if(!strcmp(name, "freq") && checkFreq(value)){
+        signal_set_freq(&gSignal, value);
+    }
+    else if(!strcmp(name, "phase") && checkPhase(value)){
+        signal_set_phase(&gSignalB, value);
+    }
+    else if(!strcmp(name, "duty") && checkDuty(value)){
+        signal_set_duty(gEdit, value);
+    }
+    else if(!strcmp(name, "interp") && value <= 1){
+        gSignal.STATE.interp = value;
+    }
+    else if(!strcmp(name, "prbs") && checkPrbs(value)){
+        noise_set_prbs(&gNoise, value);
+    }
+    else if(!strcmp(name, "requant") && value <= DAC_REQ_SHAPE){
+        gDac.requant = value;
+    }
+    else if(!strcmp(name, "clk") && value < CLOCK_PROFILES && clock_profile_set(&gClockProfiles[value])){
+        updateClocks();
+        clock_profile_report();
+    }
+    else if(!strcmp(name, "out") && value <= 1){
+        setOutput(value);
+    }
+    else if(!strcmp(name, "bench")){
+        benchmarkOutput();
+    }
+    else if(!strcmp(name, "test")){
+        uint32_t n, bad = wt_check(&gWave, &n);
+        printf("interp0: %lu of %lu codes differ from wt_ref_next\n", (unsigned long)bad, (unsigned long)n);
+        ok = startSelfTest();
+        if(ok)
+            gLoopBurst = false;
+    }
+    else if(!strcmp(name, "sync") && value <= 1){
+        ok = dac_set_sync(&gDac, gLed, value);
+    }
+    else if(!strcmp(name, "mark") && value < SAMPLE){
+        gMarks[value/8] ^= 1 << value%8;
+    }
+    else if(!strcmp(name, "save") && value < PRESET_SLOTS){
+        savePreset(value);
+        build = false;
+    }
+    else if(!strcmp(name, "recall") && value < PRESET_SLOTS){
+        ok = recallPreset(value);
+        build = false; // The tables of the preset are used
+    }
+    // The bursts take the ADC pin from the SIO every DAC_LOOP_PERIOD_US: not while it is a bit of the channel B
+    else if(!strcmp(name, "loop") && value <= 1 && !(value && (gDac.mask & (1UL << ST_ADC_GPIO)))){
+        dac_loop_enable(&gLoop, &gDac, value);
+        if(value)
+            ts_start(&gLoopTimer, DAC_LOOP_PERIOD_US, DAC_LOOP_PERIOD_US);
+        else
+            ts_stop(&gLoopTimer);
+    }
+    else{
+        ok = false;
+    }
+
+    if(ok && build){
+        updateSignal();
+    }
+    printf("%s\n", ok ? "ok" : "error");
+}
+
+bool processCalibration(const char *name, int32_t value)
+{
+    if(!strcmp(name, "code") && value >= 0 && value <= dac_code_max(&gDac)){
+        // The signal ISR and the DMA stop writing the DAC while a code is measured
+        gSignal.STATE.en = 0;
+        updateSignal();
+        gCal.cur = value;
+        dac_output_codes(&gDac, (uint16_t)value, (uint16_t)value);
+        return true;
+    }
+    if(!strcmp(name, "mv") && gCal.cur >= 0 && value >= INT16_MIN && value <= INT16_MAX){
+        return dac_cal_add(&gCal, (uint16_t)gCal.cur, (int16_t)value);
+    }
+    if(!strcmp(name, "save") && dac_cal_fit(&gCal, &gDac)){
+        dac_cal_save(&gDac);
+    }
+    else if(!strcmp(name, "reset")){
+        dac_cal_nominal(&gDac);
+        dac_cal_init(&gCal);
+    }
+    else{
+        return false;
+    }
+
+    // New transfer: the tables are built again and the generator restarts
+    gCal.cur = -1;
+    gSignal.STATE.en = 1;
+    return true;
+}
+
+void savePreset(uint8_t slot)
+{
+    static preset_t preset; // Too big for the stack of the main loop
+
+    preset.transfer = preset_transfer(&gDac);
+    preset.a = gSignal;
+    preset.b = gSignalB;
+    memcpy(preset.wt_a, gWave.table, sizeof(preset.wt_a));
+    memcpy(preset.wt_b, gWaveB.table, sizeof(preset.wt_b));
+    preset.requant = gDac.requant;
+    preset.prbs = gNoise.gen.prbs;
+    preset.sync = gDac.sync_mask != 0;
+    memcpy(preset.marks, gMarks, sizeof(preset.marks));
+    preset_save(slot, &preset);
+}
+
+bool recallPreset(uint8_t slot)
+{
+    const preset_t *preset = preset_get(slot);
+    if(!preset)
+        return false;
+
+    gDac.requant = preset->requant;
+    noise_set_prbs(&gNoise, preset->prbs);
+    dac_set_sync(&gDac, gLed, preset->sync);
+    memcpy(gMarks, preset->marks, sizeof(gMarks));
+
+    // The output and the DMA keep their state, the rest is copied from the XIP window
+    uint8_t en = gSignal.STATE.en, dma = gSignal.STATE.dma;
+    uint32_t status = save_and_disable_interrupts();
+    gSignal = preset->a;
+    gSignalB = preset->b;
+    gSignal.STATE.en = en;
+    gSignal.STATE.dma = dma;
+    memcpy(gWave.table, preset->wt_a, sizeof(gWave.table));
+    memcpy(gWaveB.table, preset->wt_b, sizeof(gWaveB.table));
+    restore_interrupts(status);
+
+    // Tables built with another transfer of the DAC, or a sync output that this backend does not have.
+    // The codes without the dither are not stored, the dithered tables are built again
+    if(preset->transfer != preset_transfer(&gDac) || preset->sync != (gDac.sync_mask != 0)
+       || preset->requant == DAC_REQ_TPDF){
+        updateSignal();
+    }
+    else{
+        startSignal();
+    }
+    return true;
+}
+
+bool startSelfTest(void)
+{
+    // The noise has no frequency, and nothing is output while disabled or calibrating
+    if(!gSignal.STATE.en || signal_is_noise(&gSignal))
+        return false;
+
+    // The frequency generated: the interpolated mode keeps the one entered, the SAMPLE 
+    // points mode has the truncation of t_sample
+    float freq = gSignal.STATE.interp ? (float)gSignal.freq : (float)S_TO_US/((float)SAMPLE*gSignal.t_sample);
+    return st_start(&gTest, &gSignal, freq);
+}
+
+void pollSelfTest(void)
+{
+    // The bursts of the closed loop only while the output runs, not while the DAC is calibrated
+    if(gLoopDue && !st_busy(&gTest)){
+        gLoopDue = false;
+        if(gLoop.en && gCal.cur < 0 && startSelfTest())
+            gLoopBurst = true;
+    }
+
+    if(st_poll(&gTest)){
+        if(!gLoopBurst){
+            st_report(&gTest);
+        }
+        else if(dac_loop_update(&gLoop, &gDac, &gTest)){
+            updateSignal(); // The tables with the new correction
+        }
+        gLoopBurst = false;
+    }
+}
+
+void pollCounter(void)
+{
+    fc_poll(&gCounter);
+}
+
+void pollConnection(void)
+{
+    static bool connected;
+
+    // What is printed at boot is lost before the terminal opens the USB CDC
+    bool now = stdio_usb_connected();
+    if(now && !connected){
+        printf("DAC: %s, %d bits, max %lu Hz\n", gDac.backend->name, gDac.backend->bits, (unsigned long)gDac.backend->max_rate(&gDac));
+        clock_profile_report();
+    }
+    connected = now;
+}
+
+void pollRebuild(void)
+{
+    if(!gRebuild) return;
+
+    // Cleared before, a key during the build asks for another one
+    gRebuild = false;
+    setOutput(gSignal.STATE.en);
+}
+
+void setOutput(bool en)
+{
+    gSignal.STATE.en = en;
+    updateSignal();
+    if(!en){
+        uint16_t code = dac_code(&gDac, 0); // 0 mV while the output is disabled
+        dac_output_codes(&gDac, code, code);
+    }
+}
+
+void managePower(void)
+{
+    // Idle while the output is disabled, the DAC is not being calibrated and no debouncer is running
+    bool idle = !gSignal.STATE.en && gCal.cur < 0 && !gKeyPad.KEY.dbnc && !gButton.KEY.dbnc && !st_busy(&gTest);
+
+    if(pw_is_idle()){
+        if(idle && !pw_woken()){
+            pw_sleep();
+            return;
+        }
+        // Wake up: the clocks, the row sequence and the alarms again
+        pw_exit();
+        updateClocks();
+        kp_set_rows(&gKeyPad, 0x00); // The column of a key held goes low, its edge comes with its row
+        ts_start(&gSeqTimer, KP_SEQ_US, KP_SEQ_US);
+        timerSignalHandler();
+        timerPrintHandler();
+        pw_ready();
+        return;
+    }
+    if(idle && !pw_keep_awake()){
+        ts_stop(&gSeqTimer);
+        kp_set_rows(&gKeyPad, 0x0F); // Any key raises its column
+        irq_set_enabled(TIMER_IRQ_0, false);    // Signal alarm
+        irq_set_enabled(TIMER_IRQ_1, false);    // Print alarm
+        pw_enter();
+        return;
+    }
+    __wfi();
+}
+
+void initTimers(void)
+{
+    ts_init(2, 0xC0); // Alarm 2, low priority as the keypad and button are slow
+    ts_timer_init(&gSeqTimer, kpSeqCallback, NULL);
+    ts_timer_init(&gKpDbncTimer, kpDebounceCallback, NULL);
+    ts_timer_init(&gBtnDbncTimer, buttonDebounceCallback, NULL);
+    ts_timer_init(&gLoopTimer, loopCallback, NULL);
+    ts_start(&gSeqTimer, KP_SEQ_US, KP_SEQ_US);
+}
+
+void updateClocks(void)
+{
+    if(gDac.backend->clk_update){
+        gDac.backend->clk_update(&gDac);
+    }
+    updateSignal(); // Rates of the DMA timers and max rate of the backend
+}
+
+void benchmarkOutput(void)
+{
+    const clock_profile_t *current = clock_profile_get();
+    const uint32_t n = 10000;
+
+    for (uint8_t i = 0; i < CLOCK_PROFILES; i++){
+        if(!clock_profile_set(&gClockProfiles[i])) continue;
+        updateClocks();
+
+        // Time of the signal ISR as it is called by the NVIC, without the entry and exit (about 26 cycles)
+        uint32_t status = save_and_disable_interrupts();
+        uint64_t t0 = time_us_64();
+        for (uint32_t k = 0; k < n; k++){
+            timerSignalHandler();
+        }
+        uint64_t t = time_us_64() - t0;
+        restore_interrupts(status);
+
+        uint32_t ns = (uint32_t)(t*1000/n);
+        uint32_t rate = ns ? 1000000000UL/ns : 0;
+        uint32_t max = gDac.backend->max_rate(&gDac);
+        printf("%s: %lu ns per sample, max %lu Hz (%s: %lu Hz)\n", gClockProfiles[i].name, (unsigned long)ns,
+               (unsigned long)(rate < max ? rate : max), gDac.backend->name, (unsigned long)max);
+    }
+
+    if(current && clock_profile_set(current)){
+        updateClocks();
+    }
+}
+
+void loopCallback(void *data)
+{
+    gLoopDue = true;
+}
+
+void kpSeqCallback(void *data)
+{
+    kp_gen_seq(&gKeyPad);
+}
+
+void kpDebounceCallback(void *data)
+{
+    uint32_t cols = kp_get_cols(&gKeyPad); // Get columns gpio values
+    if(kp_is_2nd_zero(&gKeyPad)){
+        if(!cols){
+            kp_set_irq_enabled(&gKeyPad, true); // Enable the GPIO IRQs
+            ts_start(&gSeqTimer, KP_SEQ_US, KP_SEQ_US);    // Enable the row sequence
+            ts_stop(&gKpDbncTimer);   // Disable the keypad debouncer
+            gKeyPad.KEY.dbnc = 0;
+        }
+        else
+            kp_clr_zflag(&gKeyPad);
+    }
+    else{
+        if(!cols)
+            kp_set_zflag(&gKeyPad);
+    }
+}
+
+void buttonDebounceCallback(void *data)
+{
+    bool button = button_get(&gButton);
+    if(button_is_2nd_zero(&gButton)){
+        if(!button){
+            // Only the channel A has the noise waveforms
+            signal_set_state(gEdit, (gEdit->STATE.ss + 1)%(gEdit == &gSignal ? SIGNAL_STATES : SIGNAL_PERIODIC));
+            button_set_irq_enabled(&gButton, true); // Enable the GPIO IRQs
+            ts_stop(&gBtnDbncTimer);    // Disable the button debouncer
+            gRebuild = true; // Recalculate the signal values in the main loop
+            gButton.KEY.dbnc = 0;
+        }
+        else
+            button_clr_zflag(&gButton);
+    }
+    else{
+        if(!button)
+            button_set_zflag(&gButton);
+    }
+}
 
 
 void gpioCallback(uint num, uint32_t mask) 
@@ -133,15 +608,37 @@ void gpioCallback(uint num, uint32_t mask)
     }
 }
 
+ /**
+  * @brief Turn on or off the LED of the keypad entry. Its GPIO is the sync output while it 
+  * is enabled, written with the codes, so the LED is not written then.
+  * 
+  * @param on 
+  */
+static void setLed(bool on)
+{
+    if(gDac.sync_mask) return;
+    if(on)
+        led_on(gLed);
+    else
+        led_off(gLed);
+}
+
  void keypadCallback(uint num, uint32_t mask)
  {
+    // While idle all the rows are high, the edge only wakes the core up: the row sequence captures the key
+    if(pw_is_idle()){
+        pw_wake();
+        gpio_acknowledge_irq(num, mask);
+        return;
+    }
+
     // Capture the key pressed
-    uint32_t cols = gpio_get_all() & 0x000003C0; // Get columns gpio values
+    uint32_t cols = kp_get_cols(&gKeyPad); // Get columns gpio values
     kp_capture(&gKeyPad, cols);
     // printf("Key: %02x\n", gKeyPad.KEY.dkey);
 
-    pwm_set_enabled(0, false);  // Disable the row sequence
-    pwm_set_enabled(1, true);   // Enable the keypad debouncer
+    ts_stop(&gSeqTimer);    // Disable the row sequence
+    ts_start(&gKpDbncTimer, DBNC_US, DBNC_US);   // Enable the keypad debouncer
     kp_set_irq_enabled(&gKeyPad, false); // Disable the keypad IRQs
 
     kp_set_zflag(&gKeyPad); // Set the flag that indicates that a zero was detected on keypad
@@ -163,7 +660,7 @@ void gpioCallback(uint num, uint32_t mask)
     // To accept a letter different of 0x0D, in_param_state must be 0
     else if(checkLetter(gKeyPad.KEY.dkey) && !in_param_state){
         // cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 1);
-        led_on(gLed);
+        setLed(true);
         switch (gKeyPad.KEY.dkey)
         {
         case 0x0A:
@@ -180,36 +677,67 @@ void gpioCallback(uint num, uint32_t mask)
             break;
         }
     }
+    // The # key enters the duty cycle or symmetry of the current waveform (tenths of percent), 
+    // or the order of the PRBS (7, 15, 23)
+    else if(gKeyPad.KEY.dkey == 0x0F && !in_param_state){
+        setLed(true);
+        in_param_state = 4;
+    }
     // To accept a 0x0D, in_param_state must be different of 0
     else if(gKeyPad.KEY.dkey == 0x0D && in_param_state){
         // cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 0);
-        led_off(gLed);
+        setLed(false);
         switch (in_param_state)
         {
         case 1:
             if(checkAmp(param)){
-                signal_set_amp(&gSignal,param);
+                signal_set_amp(gEdit,param);
             }
             break;
         case 2:
             if(checkOffset(param)){
-                signal_set_offset(&gSignal,param);
+                signal_set_offset(gEdit,param);
             }
             break;
-        case 3:
-            if(checkFreq(param)){
+        case 3: // The frequency is shared, for the channel B the C key sets its phase
+            if(gEdit == &gSignal && checkFreq(param)){
                 signal_set_freq(&gSignal,param);
             }
+            else if(gEdit == &gSignalB && checkPhase(param)){
+                signal_set_phase(&gSignalB,param);
+            }
+            break;
+        case 4:
+            if(gEdit->STATE.ss == 6 && checkPrbs(param)){
+                noise_set_prbs(&gNoise,param);
+            }
+            else if(checkDuty(param)){
+                signal_set_duty(gEdit,param);
+            }
             break;
         default:
             printf("Invalid state\n");
             break;
         }
-        signal_calculate(&gSignal);
+        gRebuild = true;
         in_param_state = 0;
         param = 0;
         key_cont = 0;
     }
+    // The D key alone selects the channel to edit: A or B
+    else if(gKeyPad.KEY.dkey == 0x0D && !in_param_state){
+        gEdit = (gEdit == &gSignal) ? &gSignalB : &gSignal;
+    }
+    // The 0 key alone switches the output on and off
+    else if(gKeyPad.KEY.dkey == 0x00 && !in_param_state){
+        gSignal.STATE.en = !gSignal.STATE.en;
+        gRebuild = true; // setOutput() in the main loop
+    }
+    // The * key switches between the SAMPLE points table and the interpolated wavetable
+    else if(gKeyPad.KEY.dkey == 0x0E && !in_param_state){
+        gSignal.STATE.interp = !gSignal.STATE.interp;
+        gRebuild = true;
+    }
     gKeyPad.KEY.nkey = 0;
 
     gpio_acknowledge_irq(num, mask); // gpio IRQ acknowledge
@@ -217,7 +745,8 @@ void gpioCallback(uint num, uint32_t mask)
 
  void buttonCallback(uint num, uint32_t mask)
  {
-    pwm_set_enabled(2, true); // Enable the button debouncer
+    pw_wake();
+    ts_start(&gBtnDbncTimer, DBNC_US, DBNC_US); // Enable the button debouncer
     button_set_irq_enabled(&gButton, false); // Disable the button IRQs
 
     button_set_zflag(&gButton); // Set the flag that indicates that a zero was detected on button
@@ -235,7 +764,9 @@ void gpioCallback(uint num, uint32_t mask)
     irq_set_exclusive_handler(TIMER_IRQ_0, timerSignalHandler);
     irq_set_enabled(TIMER_IRQ_0, true);
     hw_set_bits(&timer_hw->inte, 1u << TIMER_IRQ_0); // Enable alarm0 for signal value calculation
-    timer_hw->alarm[0] = (uint32_t)(time_us_64() + gSignal.t_sample); // Set alarm0 to trigger in t_sample
+    // Set alarm0 to trigger in t_sample, the interpolated mode runs at a fixed sample rate.
+    // When the DMA outputs the table, it only checks every millisecond if it must take the output again
+    timer_hw->alarm[0] = (uint32_t)(time_us_64() + (gSignal.STATE.dma ? 1000 : gSignal.STATE.interp ? WT_T_SAMPLE : gSignal.t_sample));
 
     timerSignalCallback();
 
@@ -244,8 +775,23 @@ void gpioCallback(uint num, uint32_t mask)
  void timerSignalCallback(void)
  {
     // Perform the signal value calculation and output to the DAC
-    dac_calculate(&gDac,gSignal.arrayV[gSignal.cnt]);
-    gSignal.cnt = (gSignal.cnt + 1)%SAMPLE;
+    uint16_t code_a, code_b;
+    if(!gSignal.STATE.en || gSignal.STATE.dma) return; // The DAC is being calibrated or it is written by DMA
+    if(gSignal.STATE.interp){
+        uint16_t mark = gDac.sync_mask && wt_period_start(&gWave) ? DAC_MARK : 0; // Sync output
+        code_a = wt_next(&gWave) | mark;
+        code_b = wt_next(&gWaveB);
+    }
+    else{
+        code_a = gSignal.arrayC[gSignal.cnt];
+        code_b = gSignalB.arrayC[gSignalB.cnt];
+        gSignal.cnt = (gSignal.cnt + 1)%SAMPLE;
+        gSignalB.cnt = (gSignalB.cnt + 1)%SAMPLE;
+    }
+    if(signal_is_noise(&gSignal)){
+        code_a = noise_next(&gNoise);
+    }
+    dac_output_codes(&gDac, code_a, code_b);
     
  }
 
@@ -265,10 +811,14 @@ void gpioCallback(uint num, uint32_t mask)
 
  }
 
- void timerPrintCallback(void)
- {
-    // Print the signal characteristics
-    switch (gSignal.STATE.ss){
+ /**
+  * @brief Print the name of the waveform of a channel.
+  * 
+  * @param signal 
+  */
+static void printWaveform(signal_t *signal)
+{
+    switch (signal->STATE.ss){
         case 0:
             printf("Sinusoidal: ");
             break;
@@ -281,7 +831,35 @@ void gpioCallback(uint num, uint32_t mask)
         case 3:
             printf("Square: ");
             break;
+        case 4:
+            printf("White noise: ");
+            break;
+        case 5:
+            printf("Pink noise: ");
+            break;
+        case 6:
+            printf("PRBS-%d: ", gNoise.gen.prbs);
+            break;
+    }
+}
+
+ void timerPrintCallback(void)
+ {
+    // Print the signal characteristics
+    printf("%sA-> ", gEdit == &gSignal ? "*" : " ");
+    printWaveform(&gSignal);
+    char measured[16] = "n/a"; // The input of the counter does not toggle with this output
+    if(gCounterValid){
+        snprintf(measured, sizeof(measured), "%.3f", fc_freq(&gCounter));
     }
-    printf("Amp: %d, Offset: %d, Freq: %d\n", gSignal.amp, gSignal.offset, gSignal.freq);
+    printf("Amp: %d, Offset: %d, Freq: %d (measured %s), Duty: %d%s\n", gSignal.amp, gSignal.offset, gSignal.freq,
+           measured, signal_is_noise(&gSignal) ? 0 : gSignal.duty[gSignal.STATE.ss],
+           gSignal.STATE.interp ? " (interpolated)" : "");
+    printf("%sB-> ", gEdit == &gSignalB ? "*" : " ");
+    printWaveform(&gSignalB);
+    printf("Amp: %d, Offset: %d, Phase: %d, Duty: %d\n", gSignalB.amp, gSignalB.offset, gSignalB.phase,
+           gSignalB.duty[gSignalB.STATE.ss]);
+    pw_report();
+    dac_loop_report(&gLoop);
 
  }
@@ -12,6 +12,10 @@
 #define __FUNTCS_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#define KP_SEQ_US   2000        // Period of the row sequence of the keypad
+#define DBNC_US     100000      // Period of the debouncers
 
 /**
  * @brief This function initializes the global variables of the system: keypad, signal generator, button, and DAC.
@@ -20,22 +24,178 @@
 void initGlobalVariables(void);
 
 /**
- * @brief This function initializes a PWM signal as a periodic interrupt timer (PIT).
- * Each slice will generate interruptions at a period of milis miliseconds.
- * Due to each slice share clock counter (period), events with diferents periods 
- * must not be generated in the same slice, i.e, they must not share channel.
+ * @brief This function recalculates the signal values after a change of its parameters.
+ * In the interpolated mode, it also rebuilds the wavetable. Only from the main loop: the 
+ * interruptions set gRebuild (pollRebuild()).
+ * 
+ */
+void updateSignal(void);
+
+/**
+ * @brief This function starts the output of the tables already built: the frequency of the 
+ * wavetables, the noise, the phase of the channel B and the DMA. It is called by updateSignal() 
+ * and by recallPreset(), which does not build them.
+ * 
+ */
+void startSignal(void);
+
+/**
+ * @brief This function fills the output buffers that were consumed by the signal ISR,
+ * and draws a new dither for the tables once per period with requant 1.
+ * It is called from the main loop, out of the interruptions.
+ * 
+ */
+void refillBuffers(void);
+
+/**
+ * @brief This function executes the commands received by the serial or USB interface:
+ * ch, wave, amp, offset, freq, phase, duty, interp, prbs, requant, clk, bench, test, loop, sync, mark, save and recall, followed by their value,
+ * and the calibration commands (cal_*). It is called from the main loop.
+ * 
+ */
+void processCommands(void);
+
+/**
+ * @brief This function executes a calibration command of the DAC (see dac_cal.h):
+ * code, mv, save or reset, without the "cal_" prefix.
+ * 
+ * @param name 
+ * @param value 
+ * @return true if the command was accepted
+ */
+bool processCalibration(const char *name, int32_t value);
+
+/**
+ * @brief This function saves the parameters and the tables of both channels in a preset 
+ * of the flash (see preset.h).
+ * 
+ * @param slot 0 to PRESET_SLOTS - 1
+ */
+void savePreset(uint8_t slot);
+
+/**
+ * @brief This function restores a preset: the tables are copied from the flash, they are 
+ * only built again if the transfer of the DAC changed since it was saved.
+ * 
+ * @param slot 
+ * @return false if the slot is empty
+ */
+bool recallPreset(uint8_t slot);
+
+/**
+ * @brief This function starts the self-test of the channel A (see selftest.h): a burst of 
+ * the ADC is captured while the generator runs, and it is analyzed by the core 1.
+ * 
+ * @return false if the output is disabled, it is noise or a burst is running
+ */
+bool startSelfTest(void);
+
+/**
+ * @brief This function prints the result of the self-test when it is ready, and runs the 
+ * bursts of the closed loop (dac_loop.h): their results update the correction of the DAC 
+ * instead. It is called from the main loop.
  * 
- * @param slice 
- * @param milis Period of the PWM interruption in miliseconds
- * @param enable 
  */
-void initPWMasPIT(uint8_t slice, uint16_t milis, bool enable);
+void pollSelfTest(void);
 
 /**
- * @brief This function is the handler for the PWM interruptions.
+ * @brief This function reads the measurements of the frequency counter (freq_counter.h), 
+ * which is printed next to the frequency entered. It is called from the main loop.
  * 
  */
-void pwmIRQ(void);
+void pollCounter(void);
+
+/**
+ * @brief This function prints the backend of the DAC and the clock profile report when a
+ * terminal opens the USB CDC: at boot they are printed before any terminal can read them.
+ * It is called from the main loop.
+ * 
+ */
+void pollConnection(void);
+
+/**
+ * @brief This function selects the input of the frequency counter: the sync output when it
+ * is enabled (without markers), otherwise the MSB of the channel A, which is only measured
+ * when it is driven and the codes cross the middle of the range. The measurement is printed
+ * as n/a when the input does not toggle once per period. It is called by startSignal().
+ * 
+ */
+void updateCounter(void);
+
+/**
+ * @brief This function builds the tables again when the keypad or the button changed the 
+ * signal. Their interruptions only set gRebuild: updateSignal() is only called from the main
+ * loop, so it does not run twice at the same time.
+ * 
+ */
+void pollRebuild(void);
+
+/**
+ * @brief This function enables or disables the output. While it is disabled, the DAC 
+ * outputs 0 mV and the core can be idle.
+ * 
+ * @param en 
+ */
+void setOutput(bool en);
+
+/**
+ * @brief This function is called from the main loop instead of __wfi(). While the output 
+ * is disabled, the core enters the low-power idle mode (power.h) and leaves it when a key 
+ * or the button is pressed or the output is enabled again.
+ * 
+ */
+void managePower(void);
+
+/**
+ * @brief This function initializes the timer service and the timers of the keypad and 
+ * the button, and starts the row sequence.
+ * 
+ */
+void initTimers(void);
+
+/**
+ * @brief This function configures again everything that depends on clk_sys, 
+ * after a change of clock profile: the DAC backend and the DMA rates.
+ * 
+ */
+void updateClocks(void);
+
+/**
+ * @brief This function measures the time of the signal ISR in each clock profile
+ * and prints the max output rate. The clock profile is restored after it.
+ * 
+ */
+void benchmarkOutput(void);
+
+/**
+ * @brief Timer callback of the closed loop: a burst is due.
+ * 
+ * @param data 
+ */
+void loopCallback(void *data);
+
+/**
+ * @brief Timer callback that generates the row sequence of the keypad.
+ * 
+ * @param data 
+ */
+void kpSeqCallback(void *data);
+
+/**
+ * @brief Timer callback of the keypad debouncer. When the keys are released, the 
+ * row sequence starts again.
+ * 
+ * @param data 
+ */
+void kpDebounceCallback(void *data);
+
+/**
+ * @brief Timer callback of the button debouncer. When the button is released, the 
+ * waveform changes.
+ * 
+ * @param data 
+ */
+void buttonDebounceCallback(void *data);
 
 /** 
  * @brief Definition of the handler for the signal generation interruptions, 
@@ -119,5 +279,17 @@ static inline bool checkOffset(uint32_t offset){
     return (offset >= 50 && offset <= 1250);
 }
 
+static inline bool checkPhase(uint32_t phase){
+    return (phase <= 359);
+}
+
+static inline bool checkDuty(uint32_t duty){
+    return (duty <= 1000);
+}
+
+static inline bool checkPrbs(uint32_t order){
+    return (order == 7 || order == 15 || order == 23);
+}
+
 #endif // FUNTCS
 
@@ -25,7 +25,7 @@
  * ISR: Input Shift Register
  * PIT: Periodic Interrupt Timer
  * 
- * Interrupts:  button debouncer, keypad debouncer, secuence -> Slices 0,1,2 of the PWM
+ * Interrupts:  button debouncer, keypad debouncer, secuence -> Timer service on alarm 2
  *              value calculation, printing -> Timers 0, 1
  *              gpio columns -> GPIO 
  * 
@@ -44,30 +44,32 @@
 #include "hardware/sync.h"
 
 #include "functs.h"
+#include "clock_profile.h"
 
 
 int main() {
+    clock_profile_set(&gClockProfiles[CLOCK_PROFILE_BOOT]); // Before the peripherals that divide clk_sys
     stdio_init_all();
     printf("Hola!!!");
 
     // Initialize global variables: keypad, signal generator, button, and DAC.
     initGlobalVariables();
 
-    // Initialize the PWM slices as PIT.
-    initPWMasPIT(0,2,true);     // 2ms for the secuence generation
-    initPWMasPIT(1,100,false);  // 100ms for the keypad debouncer
-    initPWMasPIT(2,100, false); // 100ms for the button debouncer
+    // Initialize the timers: 2ms for the secuence generation, 100ms for the keypad and button debouncers.
+    initTimers();
 
     // Initialize two timers: one for the value calculation and the other for the printing.
     timerSignalHandler();
     timerPrintHandler();
 
-    // For the PWM interruption, it specifies the handler.
-    irq_set_exclusive_handler(PWM_IRQ_WRAP,pwmIRQ);
-    irq_set_priority(PWM_IRQ_WRAP, 0xC0);
-
     while(1){
-        __wfi();
+        refillBuffers();
+        pollRebuild();
+        processCommands();
+        pollSelfTest();
+        pollCounter();
+        pollConnection();
+        managePower(); // __wfi(), or the idle mode while the output is disabled
     }
 }
 
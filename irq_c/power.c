@@ -0,0 +1,150 @@
+/**
+ * \file        power.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+#include "hardware/xosc.h"
+#include "hardware/sync.h"
+
+#include "power.h"
+#include "clock_profile.h"
+
+static uint32_t gWakeMask;                  // GPIOs that wake the core up
+static bool gIdle;
+static volatile bool gWoken;
+static uint64_t gWakeAt;                    // Time of the wake edge
+static uint64_t gAwakeUntil;                // Min time awake after the last wake up
+static const clock_profile_t *gRunProfile;  // Profile to restore
+static uint32_t gWakes;                     // Wake-ups since the last report
+static uint32_t gWakeMax;                   // Longest wake-up since the last report, in us
+static uint32_t gWakeLast;                  // Last wake-up, in us
+
+void pw_init(uint32_t wake_mask)
+{
+    gWakeMask = wake_mask;
+    gIdle = false;
+    gWoken = false;
+    gWakeAt = 0;
+    gAwakeUntil = 0;
+    gWakes = 0;
+    gWakeMax = 0;
+    gWakeLast = 0;
+}
+
+void pw_enter(void)
+{
+    gRunProfile = clock_profile_get();
+    clock_profile_set(&gClockProfiles[PW_IDLE_PROFILE]);
+    gWoken = false;
+    gIdle = true;
+}
+
+#if PW_DORMANT
+/**
+ * @brief Run from the XOSC, stop the PLLs and wait in the dormant mode for a wake edge.
+ * The clocks of the boot are set again after it.
+ *
+ */
+static void pw_dormant(void)
+{
+    uint32_t hz = XOSC_KHZ*1000;
+    clock_configure(clk_ref, CLOCKS_CLK_REF_CTRL_SRC_VALUE_XOSC_CLKSRC, 0, hz, hz);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLK_REF, 0, hz, hz);
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS, hz, hz);
+    clock_stop(clk_usb);
+    clock_stop(clk_adc);
+    pll_deinit(pll_sys);
+    pll_deinit(pll_usb);
+
+    for (uint i = 0; i < 30; i++){
+        if(gWakeMask & (1u << i))
+            gpio_set_dormant_irq_enabled(i, GPIO_IRQ_EDGE_RISE, true);
+    }
+    xosc_dormant(); // Stops here until a wake edge
+    gWakeAt = time_us_64(); // The timer counts again
+    gWoken = true;
+    for (uint i = 0; i < 30; i++){
+        if(gWakeMask & (1u << i)){
+            gpio_set_dormant_irq_enabled(i, GPIO_IRQ_EDGE_RISE, false);
+            gpio_acknowledge_irq(i, GPIO_IRQ_EDGE_RISE);
+        }
+    }
+    clocks_init();
+}
+#endif
+
+void pw_sleep(void)
+{
+#if PW_DORMANT
+    uint32_t status = save_and_disable_interrupts();
+    if(!gWoken){
+        pw_dormant();
+    }
+    restore_interrupts(status);
+#else
+    __wfi();
+#endif
+}
+
+void pw_exit(void)
+{
+    if(gRunProfile){
+        clock_profile_set(gRunProfile);
+    }
+    gIdle = false;
+    gAwakeUntil = time_us_64() + PW_AWAKE_US;
+}
+
+void pw_ready(void)
+{
+    if(!gWoken) return; // Not woken up by an edge: a command enabled the output
+    gWoken = false;
+    gWakeLast = (uint32_t)(time_us_64() - gWakeAt);
+    if(gWakeLast > gWakeMax)
+        gWakeMax = gWakeLast;
+    gWakes++;
+}
+
+void pw_wake(void)
+{
+    if(gIdle && !gWoken){
+        gWakeAt = time_us_64();
+        gWoken = true;
+    }
+}
+
+bool pw_is_idle(void)
+{
+    return gIdle;
+}
+
+bool pw_woken(void)
+{
+    return gWoken;
+}
+
+bool pw_keep_awake(void)
+{
+    return time_us_64() < gAwakeUntil;
+}
+
+void pw_report(void)
+{
+    if(!gWakes) return;
+    printf("Wake-ups: %lu, last %lu us, max %lu us\n", (unsigned long)gWakes, (unsigned long)gWakeLast,
+           (unsigned long)gWakeMax);
+    gWakes = 0;
+    gWakeMax = 0;
+}
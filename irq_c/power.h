@@ -0,0 +1,92 @@
+/**
+ * \file        power.h
+ * \brief       Low-power idle while the output is disabled.
+ * \details     In the idle mode nothing has to run: the caller stops the row sequence
+ * of the keypad (all the rows are driven high, so any key raises its column), and the
+ * signal and print alarms. clk_sys is lowered to the PW_IDLE_PROFILE profile and the core
+ * sleeps until a rising edge on one of the wake GPIOs (keypad columns and button).
+ *
+ * With PW_DORMANT the core sleeps in the dormant mode: the XOSC and the PLLs are stopped,
+ * so the timer and the USB stop too. It is for the battery builds with the stdio on the
+ * UART. Otherwise the core sleeps with __wfi(), it is woken up by the USB every ms.
+ *
+ * The wake-up time is measured from the wake edge (for the dormant mode, from the
+ * restart of the XOSC) to the moment the generator can output the first sample again.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __POWER_
+#define __POWER_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef PW_DORMANT
+#define PW_DORMANT          0       // 1 to sleep in the dormant mode, the USB is lost
+#endif
+#define PW_IDLE_PROFILE     0       // Clock profile while idle: 48 MHz
+#define PW_AWAKE_US         20000   // Min time awake after a wake up, the row sequence finds the key
+
+/**
+ * @brief Set the GPIOs that wake the core up with a rising edge
+ *
+ * @param wake_mask
+ */
+void pw_init(uint32_t wake_mask);
+
+/**
+ * @brief Enter the idle mode: the clock of the idle profile. The caller must stop
+ * the periodic interrupts before.
+ *
+ */
+void pw_enter(void);
+
+/**
+ * @brief Sleep until an interrupt, or until a wake edge in the dormant mode.
+ *
+ */
+void pw_sleep(void);
+
+/**
+ * @brief Leave the idle mode: the clock profile that was set before pw_enter().
+ * The caller must recompute the dividers of clk_sys and start the interrupts again.
+ *
+ */
+void pw_exit(void);
+
+/**
+ * @brief The generator can output again, the wake-up time is taken
+ *
+ */
+void pw_ready(void);
+
+/**
+ * @brief Called from the GPIO ISR: a wake edge while idle
+ *
+ */
+void pw_wake(void);
+
+bool pw_is_idle(void);
+
+/**
+ * @brief A wake edge arrived since pw_enter()
+ *
+ */
+bool pw_woken(void);
+
+/**
+ * @brief The core must stay awake after the last wake up
+ *
+ */
+bool pw_keep_awake(void);
+
+/**
+ * @brief Print the wake-up times since the last report
+ *
+ */
+void pw_report(void);
+
+#endif // __POWER_
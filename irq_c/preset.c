@@ -0,0 +1,165 @@
+/**
+ * \file        preset.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+
+#include "preset.h"
+
+/**
+ * @typedef preset_flash_t
+ *
+ * @brief Layout of a preset in its sector
+ *
+ */
+typedef struct{
+    uint32_t magic;
+    uint32_t crc;           // CRC-32 from seq to the end, to detect a sector that was not completely programmed
+    uint32_t seq;           // Order of the saves, the highest of a slot is its preset
+    uint32_t slot;
+    preset_t preset;
+}preset_flash_t;
+
+#define PRESET_PAGES    ((sizeof(preset_flash_t) + FLASH_PAGE_SIZE - 1)/FLASH_PAGE_SIZE)
+
+static_assert(PRESET_PAGES*FLASH_PAGE_SIZE <= FLASH_SECTOR_SIZE, "A preset must fit in a sector");
+
+/**
+ * @brief CRC-32 (IEEE), with a table of 16 entries: 2 steps of 4 bits per byte
+ *
+ * @param crc   0xFFFFFFFF at the start, the result of the previous part to continue
+ * @param data
+ * @param n     Bytes
+ * @return The CRC is the inverse of the last result
+ */
+static uint32_t preset_crc(uint32_t crc, const void *data, uint32_t n)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    const uint8_t *p = data;
+    for (uint32_t i = 0; i < n; i++){
+        crc ^= p[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return crc;
+}
+
+static const preset_flash_t *preset_sector(uint8_t i)
+{
+    return (const preset_flash_t *)(XIP_BASE + PRESET_OFFSET + (uint32_t)i*FLASH_SECTOR_SIZE);
+}
+
+static bool preset_valid(const preset_flash_t *rec)
+{
+    uint32_t n = sizeof(preset_flash_t) - offsetof(preset_flash_t, seq);
+    return rec->crc == ~preset_crc(0xFFFFFFFF, &rec->seq, n);
+}
+
+/**
+ * @brief Sector of the last valid preset of a slot. The CRC is only checked from the highest
+ * sequence down, until a valid one.
+ *
+ * @param slot  -1 for any slot
+ * @return The sector, -1 if there is none
+ */
+static int8_t preset_find(int16_t slot)
+{
+    uint32_t bound = UINT32_MAX;
+    while(1){
+        int8_t best = -1;
+        for (uint8_t i = 0; i < PRESET_SECTORS; i++){
+            const preset_flash_t *rec = preset_sector(i);
+            if(rec->magic == PRESET_MAGIC && rec->slot < PRESET_SLOTS && (slot < 0 || rec->slot == (uint32_t)slot)
+               && rec->seq < bound && (best < 0 || rec->seq > preset_sector(best)->seq))
+                best = i;
+        }
+        if(best < 0 || preset_valid(preset_sector(best)))
+            return best;
+        bound = preset_sector(best)->seq; // Not completely programmed: the previous one
+    }
+}
+
+uint32_t preset_transfer(const dac_t *dac)
+{
+    uint32_t crc = preset_crc(0xFFFFFFFF, dac->cal, sizeof(dac->cal));
+    crc = preset_crc(crc, &dac->corr_gain, sizeof(dac->corr_gain));
+    crc = preset_crc(crc, &dac->corr_offset, sizeof(dac->corr_offset));
+    crc = preset_crc(crc, &dac->backend->bits, sizeof(dac->backend->bits));
+    return ~crc;
+}
+
+void preset_save(uint8_t slot, const preset_t *preset)
+{
+    static uint32_t page[PRESET_PAGES*FLASH_PAGE_SIZE/4]; // flash_range_program() writes whole pages
+    preset_flash_t *data = (preset_flash_t *)page;
+
+    // The last record of each slot is kept, also the one of this slot until the new one is written
+    bool live[PRESET_SECTORS] = {false};
+    for (uint8_t s = 0; s < PRESET_SLOTS; s++){
+        int8_t i = preset_find(s);
+        if(i >= 0)
+            live[i] = true;
+    }
+
+    // The free sector written the longest ago, the erased ones first
+    uint32_t seq = 0, oldest = UINT32_MAX;
+    uint8_t target = 0;
+    for (uint8_t i = 0; i < PRESET_SECTORS; i++){
+        const preset_flash_t *rec = preset_sector(i);
+        uint32_t s = rec->magic == PRESET_MAGIC ? rec->seq : 0;
+        if(s > seq)
+            seq = s;
+        if(!live[i] && s < oldest){
+            oldest = s;
+            target = i;
+        }
+    }
+
+    memset(page, 0xFF, sizeof(page));
+    data->magic = PRESET_MAGIC;
+    data->seq = seq + 1;
+    data->slot = slot;
+    memcpy(&data->preset, preset, sizeof(preset_t));
+    data->crc = ~preset_crc(0xFFFFFFFF, &data->seq, sizeof(preset_flash_t) - offsetof(preset_flash_t, seq));
+
+    // The code can not run from the flash while it is written, on any of the cores
+    uint32_t offset = PRESET_OFFSET + (uint32_t)target*FLASH_SECTOR_SIZE;
+    bool core1 = multicore_lockout_victim_is_initialized(1);
+    if(core1)
+        multicore_lockout_start_blocking();
+    uint32_t status = save_and_disable_interrupts();
+    flash_range_erase(offset, FLASH_SECTOR_SIZE);
+    flash_range_program(offset, (const uint8_t *)page, sizeof(page));
+    restore_interrupts(status);
+    if(core1)
+        multicore_lockout_end_blocking();
+}
+
+const preset_t *preset_get(uint8_t slot)
+{
+    int8_t i = slot < PRESET_SLOTS ? preset_find(slot) : -1;
+    return i < 0 ? NULL : &preset_sector(i)->preset;
+}
+
+int8_t preset_last(void)
+{
+    int8_t i = preset_find(-1);
+    return i < 0 ? -1 : (int8_t)preset_sector(i)->slot;
+}
@@ -0,0 +1,87 @@
+/**
+ * \file        preset.h
+ * \brief       Presets of the generator in the flash.
+ * \details     Each preset has the parameters of both channels and the tables already built
+ * (arrayV, arrayC and the wavetables), so a recall is a copy from the XIP window, without
+ * signal_calculate() or dac_codes(). The tables are only valid for the transfer of the DAC
+ * they were built with (calibration, correction of the closed loop and backend), which is
+ * stored with them: with another transfer they are built again.
+ *
+ * The presets are in PRESET_SECTORS sectors below the one of the calibration, one per
+ * sector, with a sequence number and a CRC-32. A save programs the free sector (not the
+ * last record of any slot) that was written the longest ago, so the erases rotate over all
+ * of them, and the previous record of the slot is kept until the new one is complete.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __PRESET_
+#define __PRESET_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/flash.h"
+
+#include "dsg_signal.h"
+#include "wavetable_ref.h"
+#include "dac.h"
+#include "dac_cal.h"
+
+#define PRESET_SLOTS    8
+#define PRESET_SECTORS  16                                                  // More than PRESET_SLOTS, for the wear leveling
+#define PRESET_MAGIC    0x45525044                                          // "DPRE"
+#define PRESET_OFFSET   (DAC_CAL_OFFSET - PRESET_SECTORS*FLASH_SECTOR_SIZE) // Below the calibration
+
+/**
+ * @typedef preset_t
+ *
+ * @brief State of the generator stored in a preset
+ *
+ */
+typedef struct{
+    uint32_t transfer;                  // Transfer of the DAC of the tables (preset_transfer())
+    signal_t a;                         // Parameters and tables of the channel A
+    signal_t b;
+    uint16_t wt_a[WT_SIZE + 1];         // Wavetables of the interpolated mode
+    uint16_t wt_b[WT_SIZE + 1];
+    uint8_t requant;
+    uint8_t prbs;
+    uint8_t sync;                       // Sync output enabled, the codes have DAC_MARK
+    uint8_t marks[(SAMPLE + 7)/8];      // Markers of the sync output
+}preset_t;
+
+/**
+ * @brief Identifier of the transfer of the DAC: calibration, correction and bit depth
+ *
+ * @param dac
+ * @return CRC-32 of them
+ */
+uint32_t preset_transfer(const dac_t *dac);
+
+/**
+ * @brief Store a preset. It takes the erase and the programming of a sector, with the
+ * interrupts disabled and the core 1 locked out.
+ *
+ * @param slot  0 to PRESET_SLOTS - 1
+ * @param preset
+ */
+void preset_save(uint8_t slot, const preset_t *preset);
+
+/**
+ * @brief Get a preset from the flash
+ *
+ * @param slot
+ * @return Pointer to the preset in the XIP window, NULL if the slot is empty
+ */
+const preset_t *preset_get(uint8_t slot);
+
+/**
+ * @brief Slot of the last preset saved, to resume it at boot
+ *
+ * @return The slot, -1 if there are no presets
+ */
+int8_t preset_last(void);
+
+#endif // __PRESET_
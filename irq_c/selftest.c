@@ -0,0 +1,218 @@
+/**
+ * \file        selftest.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#include "pico/multicore.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+#include "selftest.h"
+
+#define ST_MV_LSB   (3300.0f*ST_GAIN/4096)  // mV of the output per code of the ADC
+
+static selftest_t *volatile st_mail;        // Burst given to the core 1, NULL when it is analyzed
+
+/**
+ * @brief Frequency, mean and rms of the burst. Runs on the core 1.
+ *
+ * @param st
+ */
+static void st_analyze(selftest_t *st)
+{
+    uint64_t s = 0, s2 = 0;
+    for (uint16_t i = 0; i < ST_SAMPLES; i++){
+        s += st->buf[i];
+        s2 += (uint32_t)st->buf[i]*st->buf[i];
+    }
+    float mean = (float)s/ST_SAMPLES;
+    float var = (float)s2/ST_SAMPLES - mean*mean;
+    float sd = var > 0 ? sqrtf(var) : 0;
+
+    // Rising crossings of the mean, armed below mean - hyst so the noise does not add crossings
+    float hyst = sd/4 > 2 ? sd/4 : 2;
+    float first = 0, last = 0;
+    uint32_t n = 0;
+    bool armed = false;
+    for (uint16_t i = 1; i < ST_SAMPLES; i++){
+        float x = st->buf[i];
+        if(x < mean - hyst){
+            armed = true;
+        }
+        else if(armed && x >= mean){
+            float x0 = st->buf[i - 1];
+            float t = (i - 1) + (mean - x0)/(x - x0); // Between the samples
+            if(!n)
+                first = t;
+            last = t;
+            n++;
+            armed = false;
+        }
+    }
+
+    st->freq = n >= 2 ? (n - 1)*st->rate/(last - first) : 0;
+
+    // Mean and rms of whole periods, between the first and the last crossing
+    if(n >= 2){
+        uint16_t i0 = (uint16_t)ceilf(first), i1 = (uint16_t)ceilf(last);
+        s = s2 = 0;
+        for (uint16_t i = i0; i < i1; i++){
+            s += st->buf[i];
+            s2 += (uint32_t)st->buf[i]*st->buf[i];
+        }
+        mean = (float)s/(i1 - i0);
+        var = (float)s2/(i1 - i0) - mean*mean;
+        sd = var > 0 ? sqrtf(var) : 0;
+    }
+    st->mean = mean*ST_MV_LSB + ST_BIAS;
+    st->rms = sd*ST_MV_LSB;
+    st->amp = st->ref_rms > 0 ? st->set_amp*st->rms/st->ref_rms : 0;
+    st->offset = st->set_offset + st->mean - st->ref_mean;
+    st->pass = fabsf(st->freq - st->exp_freq) <= st->exp_freq*ST_TOL_FREQ/1000
+            && fabsf(st->amp - st->set_amp) <= (float)st->set_amp*ST_TOL_AMP/1000
+            && fabsf(st->offset - st->set_offset) <= ST_TOL_OFFSET;
+}
+
+/**
+ * @brief Core 1: analyze each burst of the mailbox and empty it when it is done.
+ */
+static void st_core1(void)
+{
+    multicore_lockout_victim_init(); // The core 0 stops it to write the flash, the FIFO is only for it
+    while(1){
+        selftest_t *st;
+        while(!(st = st_mail))
+            __wfe();
+        __dmb();
+        st_analyze(st);
+        __dmb();    // The result before the mailbox
+        st_mail = NULL;
+        __sev();
+    }
+}
+
+/**
+ * @brief Stop the ADC and give the pin back to the channel B, its direction was kept by the SIO
+ */
+static void st_stop(void)
+{
+    adc_run(false);
+    adc_fifo_drain();
+    gpio_set_function(ST_ADC_GPIO, GPIO_FUNC_SIO);
+    gpio_set_input_enabled(ST_ADC_GPIO, true);
+}
+
+void st_init(selftest_t *st)
+{
+    st->state = ST_IDLE;
+    st->timeout = false;
+    st_mail = NULL;
+    adc_init();
+    st->dma = dma_claim_unused_channel(true);
+    multicore_launch_core1(st_core1);
+}
+
+bool st_start(selftest_t *st, const signal_t *signal, float exp_freq)
+{
+    if(st_busy(st) || st_mail || exp_freq <= 0 || exp_freq > ST_ADC_RATE/ST_MIN_SPP)
+        return false;
+
+    // Reference: the table in mV, the same points for all the playback modes
+    float s = 0, s2 = 0;
+    for (uint8_t i = 0; i < SAMPLE; i++){
+        s += signal->arrayV[i];
+        s2 += (float)signal->arrayV[i]*signal->arrayV[i];
+    }
+    st->ref_mean = s/SAMPLE;
+    st->ref_rms = sqrtf(fmaxf(s2/SAMPLE - st->ref_mean*st->ref_mean, 0));
+    st->set_freq = signal->freq;
+    st->exp_freq = exp_freq;
+    st->set_amp = signal->amp;
+    st->set_offset = signal->offset;
+
+    // ST_PERIODS periods in the burst; the ADC takes 1 + div cycles of clk_adc per sample (96 min)
+    float div = ST_ADC_CLK/(exp_freq*ST_SAMPLES/ST_PERIODS) - 1;
+    if(div < ST_ADC_CLK/ST_ADC_RATE - 1)
+        div = ST_ADC_CLK/ST_ADC_RATE - 1;
+    if(div > 65535)
+        div = 65535;
+    st->rate = ST_ADC_CLK/(div + 1);
+
+    adc_gpio_init(ST_ADC_GPIO); // The pin is taken from the SIO
+    adc_select_input(ST_ADC_INPUT);
+    adc_fifo_setup(true, true, 1, false, false); // DREQ at each sample, 12 bits in 16
+    adc_set_clkdiv(div);
+    adc_fifo_drain();
+
+    dma_channel_config cfg = dma_channel_get_default_config(st->dma);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(st->dma, &cfg, st->buf, &adc_hw->fifo, ST_SAMPLES, true);
+
+    st->timeout = false;
+    st->deadline = time_us_32() + (uint32_t)(ST_SAMPLES*1e6f/st->rate) + ST_TIMEOUT_US;
+    st->state = ST_CAPTURE;
+    adc_run(true);
+    return true;
+}
+
+bool st_poll(selftest_t *st)
+{
+    if(st->state == ST_CAPTURE && !dma_channel_is_busy(st->dma)){
+        st_stop();
+        st->deadline = time_us_32() + ST_TIMEOUT_US;
+        st->state = ST_ANALYSIS;
+        __dmb();    // The burst before the mailbox
+        st_mail = st;
+        __sev();
+    }
+    else if(st->state == ST_ANALYSIS && !st_mail){
+        __dmb();
+        st->state = ST_DONE;
+        return true;
+    }
+    else if(st_busy(st) && (int32_t)(time_us_32() - st->deadline) > 0){
+        if(st->state == ST_CAPTURE){
+            dma_channel_abort(st->dma);
+            st_stop();
+        }
+        st->freq = 0;   // Not usable by the closed loop
+        st->pass = false;
+        st->timeout = true;
+        st->state = ST_DONE;
+        return true;
+    }
+    return false;
+}
+
+void st_report(const selftest_t *st)
+{
+    if(st->timeout){
+        printf("test: FAIL, timeout of the %s\n", st_mail ? "analysis" : "capture");
+        return;
+    }
+    printf("test: %s, %lu samples at %.0f Hz\n", st->pass ? "pass" : "FAIL",
+           (unsigned long)ST_SAMPLES, st->rate);
+    printf("  freq:   %.2f Hz, set %lu (%+.2f %%), generated %.2f (%+.2f %%)\n", st->freq,
+           (unsigned long)st->set_freq, 100*(st->freq - st->set_freq)/st->set_freq, st->exp_freq,
+           100*(st->freq - st->exp_freq)/st->exp_freq);
+    printf("  amp:    %.0f mV, set %u (%+.1f %%)\n", st->amp, st->set_amp,
+           100*(st->amp - st->set_amp)/st->set_amp);
+    printf("  offset: %.0f mV, set %u (%+.0f mV)\n", st->offset, st->set_offset,
+           st->offset - st->set_offset);
+}
@@ -0,0 +1,129 @@
+/**
+ * \file        selftest.h
+ * \brief       Self-test of the output: ADC loopback of the channel A.
+ * \details     The output of the LM358 is read by the ADC through a divider:
+ *      output -20k- ADC0 (GPIO 26), ADC0 -10k- 3V3, ADC0 -10k- GND
+ * so Vadc = Vout/5 + 1.32 V, and the range of the output (-2450 to 3750 mV) is inside the
+ * 0 to 3.3 V of the ADC.
+ *
+ * A burst of ST_SAMPLES samples is captured by DMA while the generator runs, at a rate that
+ * fits ST_PERIODS periods of the signal (up to 500 ksps). The core 1 estimates the frequency
+ * (rising crossings of the mean, interpolated between samples), the mean and the rms, and
+ * compares them with the table of the signal: the amplitude is scaled by the rms, so it does
+ * not depend on the waveform or the duty cycle.
+ *
+ * The burst is given to the core 1 through a mailbox (st_core1), not the FIFO between the
+ * cores: the lockout of the flash writes takes the FIFO of the core 1. A burst that does not
+ * end in its time plus ST_TIMEOUT_US is abandoned and reported as a timeout.
+ *
+ * GPIO 26 is also the bit 4 of the channel B: while a burst is captured it is given to the
+ * ADC, and the bit is not driven.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __SELFTEST_
+#define __SELFTEST_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsg_signal.h"
+
+#define ST_ADC_GPIO     26          // ADC0
+#define ST_ADC_INPUT    (ST_ADC_GPIO - 26)
+#define ST_ADC_CLK      48000000    // clk_adc, from the USB PLL
+#define ST_ADC_RATE     500000      // Max sample rate of the ADC
+#define ST_SAMPLES      4096        // Samples of a burst
+#define ST_PERIODS      8           // Min periods of the signal in a burst
+#define ST_MIN_SPP      16          // Min samples per period, the max frequency is ST_ADC_RATE/ST_MIN_SPP
+#define ST_GAIN         5           // Divider: Vout = ST_GAIN*Vadc + ST_BIAS
+#define ST_BIAS         -6600       // mV
+#define ST_TOL_FREQ     10          // Go/no-go: frequency within 1.0 % of the one generated
+#define ST_TOL_AMP      50          // Go/no-go: amplitude within 5.0 %
+#define ST_TOL_OFFSET   60          // Go/no-go: offset within 60 mV (1.5 LSB of the DAC0808)
+#define ST_TIMEOUT_US   500000      // Margin of the capture and the analysis
+
+#define ST_IDLE         0
+#define ST_CAPTURE      1           // The DMA fills the buffer
+#define ST_ANALYSIS     2           // The core 1 analyzes the buffer
+#define ST_DONE         3           // The result is ready
+
+/**
+ * @typedef selftest_t
+ *
+ * @brief Structure to manage the self-test: burst, reference and result
+ *
+ */
+typedef struct{
+    uint16_t buf[ST_SAMPLES];       // Codes of the ADC
+    int dma;                        // Channel that reads the FIFO of the ADC
+    volatile uint8_t state;         // ST_IDLE, ST_CAPTURE, ST_ANALYSIS or ST_DONE
+    float rate;                     // Sample rate of the burst
+    uint32_t deadline;              // Time in us of the end of the capture or the analysis, plus ST_TIMEOUT_US
+    // Reference, taken when the burst starts
+    uint32_t set_freq;              // Frequency entered
+    float exp_freq;                 // Frequency generated: the one entered after the truncation of t_sample
+    uint16_t set_amp;
+    uint16_t set_offset;
+    float ref_mean;                 // Mean of the table, in mV
+    float ref_rms;                  // rms of the table around its mean, in mV
+    // Result, calculated by the core 1
+    float freq;                     // Hz, 0 if there were not two crossings
+    float mean;                     // mV
+    float rms;                      // mV
+    float amp;                      // Amplitude of the output: set_amp*rms/ref_rms
+    float offset;                   // Offset of the output: set_offset + mean - ref_mean
+    bool pass;
+    bool timeout;                   // The burst did not end: no result
+}selftest_t;
+
+/**
+ * @brief Initialize the ADC and the DMA channel, and start the core 1, which waits for
+ * the bursts. The core 1 can be locked out to write the flash.
+ *
+ * @param st
+ */
+void st_init(selftest_t *st);
+
+/**
+ * @brief Start a burst. The reference is taken from the signal.
+ *
+ * @param st
+ * @param signal
+ * @param exp_freq  Frequency generated, in Hz
+ * @return false if a burst is running, the core 1 did not end the last analysis, or the
+ * frequency is above ST_ADC_RATE/ST_MIN_SPP
+ */
+bool st_start(selftest_t *st, const signal_t *signal, float exp_freq);
+
+/**
+ * @brief Called from the main loop: at the end of the burst the ADC pin goes back to the
+ * DAC and the core 1 analyzes it. After the deadline the burst is stopped, with timeout set.
+ *
+ * @param st
+ * @return true once, when the result is ready or the burst timed out
+ */
+bool st_poll(selftest_t *st);
+
+/**
+ * @brief A burst is being captured or analyzed
+ *
+ * @param st
+ * @return true
+ */
+static inline bool st_busy(const selftest_t *st)
+{
+    return st->state == ST_CAPTURE || st->state == ST_ANALYSIS;
+}
+
+/**
+ * @brief Print the result and its deviation from the parameters entered
+ *
+ * @param st
+ */
+void st_report(const selftest_t *st);
+
+#endif // __SELFTEST_
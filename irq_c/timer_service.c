@@ -0,0 +1,150 @@
+/**
+ * \file        timer_service.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+#include "timer_service.h"
+
+static ts_timer_t *gHeap[TS_TIMERS];    // Min-heap by deadline
+static uint8_t gCount;                  // Timers in the heap
+static uint8_t gAlarm;                  // Hardware alarm used
+
+static void ts_place(uint8_t i, ts_timer_t *timer)
+{
+    gHeap[i] = timer;
+    timer->pos = (int8_t)i;
+}
+
+static void ts_sift_up(uint8_t i)
+{
+    ts_timer_t *timer = gHeap[i];
+    while(i > 0){
+        uint8_t parent = (i - 1)/2;
+        if(gHeap[parent]->deadline <= timer->deadline) break;
+        ts_place(i, gHeap[parent]);
+        i = parent;
+    }
+    ts_place(i, timer);
+}
+
+static void ts_sift_down(uint8_t i)
+{
+    ts_timer_t *timer = gHeap[i];
+    while(1){
+        uint8_t child = 2*i + 1;
+        if(child >= gCount) break;
+        if(child + 1 < gCount && gHeap[child + 1]->deadline < gHeap[child]->deadline) child++;
+        if(timer->deadline <= gHeap[child]->deadline) break;
+        ts_place(i, gHeap[child]);
+        i = child;
+    }
+    ts_place(i, timer);
+}
+
+static void ts_insert(ts_timer_t *timer)
+{
+    assert(gCount < TS_TIMERS);
+    gHeap[gCount] = timer;
+    ts_sift_up(gCount++);
+}
+
+static void ts_remove(ts_timer_t *timer)
+{
+    uint8_t i = (uint8_t)timer->pos;
+    timer->pos = -1;
+    if(i == --gCount) return;
+
+    // The last timer takes its place, it can go up or down
+    ts_timer_t *last = gHeap[gCount];
+    gHeap[i] = last;
+    ts_sift_up(i);
+    ts_sift_down((uint8_t)last->pos);
+}
+
+/**
+ * @brief Arm the alarm with the nearest deadline
+ *
+ * @return false if the deadline has already passed
+ */
+static bool ts_arm(void)
+{
+    if(!gCount){
+        hw_clear_bits(&timer_hw->inte, 1u << gAlarm);
+        return true;
+    }
+    hw_set_bits(&timer_hw->inte, 1u << gAlarm);
+    timer_hw->alarm[gAlarm] = (uint32_t)gHeap[0]->deadline;
+    return (int64_t)(gHeap[0]->deadline - time_us_64()) > 0;
+}
+
+static void ts_irq(void)
+{
+    hw_clear_bits(&timer_hw->intr, 1u << gAlarm); // Interrupt acknowledge
+    hw_clear_bits(&timer_hw->intf, 1u << gAlarm); // Forced by ts_start()
+
+    do{
+        while(gCount && gHeap[0]->deadline <= time_us_64()){
+            ts_timer_t *timer = gHeap[0];
+            ts_remove(timer);
+            if(timer->period){
+                timer->deadline += timer->period;
+                ts_insert(timer);
+            }
+            timer->cb(timer->data);
+        }
+    }while(!ts_arm()); // The next deadline passed while the callbacks were running
+}
+
+void ts_init(uint8_t alarm_num, uint8_t priority)
+{
+    gAlarm = alarm_num;
+    gCount = 0;
+    irq_set_exclusive_handler(TIMER_IRQ_0 + alarm_num, ts_irq);
+    irq_set_priority(TIMER_IRQ_0 + alarm_num, priority);
+    irq_set_enabled(TIMER_IRQ_0 + alarm_num, true);
+}
+
+void ts_timer_init(ts_timer_t *timer, ts_callback_t cb, void *data)
+{
+    timer->cb = cb;
+    timer->data = data;
+    timer->period = 0;
+    timer->pos = -1;
+}
+
+void ts_start(ts_timer_t *timer, uint32_t delay_us, uint32_t period_us)
+{
+    uint32_t status = save_and_disable_interrupts();
+    if(ts_is_active(timer))
+        ts_remove(timer);
+    timer->deadline = time_us_64() + delay_us;
+    timer->period = period_us;
+    ts_insert(timer);
+    if(!ts_arm())
+        hw_set_bits(&timer_hw->intf, 1u << gAlarm); // Force the IRQ, the deadline already passed
+    restore_interrupts(status);
+}
+
+void ts_stop(ts_timer_t *timer)
+{
+    uint32_t status = save_and_disable_interrupts();
+    if(ts_is_active(timer)){
+        ts_remove(timer);
+        ts_arm();
+    }
+    restore_interrupts(status);
+}
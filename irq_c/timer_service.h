@@ -0,0 +1,85 @@
+/**
+ * \file        timer_service.h
+ * \brief       Software timers on a single hardware alarm.
+ * \details     The timers are kept in a binary heap ordered by deadline (64-bit, us),
+ * the alarm is armed with the nearest one. Insert and remove are O(log n). The 
+ * periods are not limited by a counter (as the 262 ms of a PWM slice) and do not 
+ * depend on clk_sys: the timer counts microseconds from clk_ref.
+ *
+ * The callbacks run in the IRQ of the alarm. A periodic timer is queued again 
+ * before its callback, so the callback can stop it.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __TIMER_SERVICE_
+#define __TIMER_SERVICE_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TS_TIMERS   8       // Max timers queued at the same time
+
+typedef void (*ts_callback_t)(void *data);
+
+/**
+ * @typedef ts_timer_t
+ *
+ * @brief Software timer
+ *
+ */
+typedef struct{
+    uint64_t deadline;      // Time of the next expiration, in us
+    uint32_t period;        // Period in us, 0 for a one-shot timer
+    ts_callback_t cb;       // Function called at each expiration
+    void *data;             // Argument of cb
+    int8_t pos;             // Position in the heap, -1 if the timer is stopped
+}ts_timer_t;
+
+/**
+ * @brief Initialize the service on a hardware alarm and enable its IRQ
+ *
+ * @param alarm_num 0 to 3, the alarm must not be used by anything else
+ * @param priority  Priority of the IRQ of the alarm
+ */
+void ts_init(uint8_t alarm_num, uint8_t priority);
+
+/**
+ * @brief Initialize a timer, stopped
+ *
+ * @param timer
+ * @param cb
+ * @param data
+ */
+void ts_timer_init(ts_timer_t *timer, ts_callback_t cb, void *data);
+
+/**
+ * @brief Start a timer, or restart it if it is running. It can be called from an IRQ.
+ *
+ * @param timer
+ * @param delay_us  Time to the first expiration
+ * @param period_us Period of the next expirations, 0 for a one-shot timer
+ */
+void ts_start(ts_timer_t *timer, uint32_t delay_us, uint32_t period_us);
+
+/**
+ * @brief Stop a timer. It can be called from an IRQ.
+ *
+ * @param timer
+ */
+void ts_stop(ts_timer_t *timer);
+
+/**
+ * @brief Check if a timer is queued
+ *
+ * @param timer
+ * @return true
+ */
+static inline bool ts_is_active(const ts_timer_t *timer)
+{
+    return timer->pos >= 0;
+}
+
+#endif // __TIMER_SERVICE_
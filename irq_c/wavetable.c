@@ -0,0 +1,97 @@
+/**
+ * \file        wavetable.c
+ * \brief
+ * \details
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/interp.h"
+#include "hardware/sync.h"
+
+#include "wavetable.h"
+#include "requant_ref.h"
+#include "dac.h"
+
+#define WT_CHECK_STEP   0x00A5A5A5u     // Step of the check, with low bits that carry into alpha and the index
+
+static wavetable_t wt_check_wave;       // Random codes of the check, output by the interpolator of the wavetable
+
+
+void wt_init(wavetable_t *wt, interp_hw_t *interp, uint32_t freq)
+{
+    wt->interp = interp;
+    wt->phase = 0;
+    wt_set_freq(wt, freq);
+    for (uint16_t i = 0; i <= WT_SIZE; i++){
+        wt->table[i] = 0;
+    }
+    if(!interp)
+        return; // Software blend
+
+    // Lane 0: index of the table times 2 (bytes per code), the FULL result adds it to base2 (table address)
+    interp_config cfg = interp_default_config();
+    interp_config_set_shift(&cfg, 32 - WT_BITS - 1);
+    interp_config_set_mask(&cfg, 1, WT_BITS);
+    interp_config_set_blend(&cfg, true);
+    interp_set_config(interp, 0, &cfg);
+
+    // Lane 1: alpha, taken from the bits below the index of accum0
+    cfg = interp_default_config();
+    interp_config_set_shift(&cfg, WT_FRAC_SHIFT);
+    interp_config_set_mask(&cfg, 0, 7);
+    interp_config_set_signed(&cfg, true);
+    interp_config_set_cross_input(&cfg, true);
+    interp_set_config(interp, 1, &cfg);
+
+    interp->accum[0] = 0;                       // Phase accumulator
+    interp->base[2] = (uintptr_t)wt->table;
+}
+
+void wt_build(wavetable_t *wt, signal_t *signal, const dac_t *dac)
+{
+    wt_ref_build(wt->table, wt->q, signal, dac);
+}
+
+uint32_t wt_check(const wavetable_t *wt, uint32_t *n)
+{
+    wavetable_t *t = &wt_check_wave;
+    uint32_t x = 0x2545F491u;
+    uint32_t bad = 0;
+
+    *n = 0;
+    if(!wt->interp)
+        return 0;
+    for (uint16_t i = 0; i < WT_SIZE; i++){
+        t->table[i] = (uint16_t)(rq_ref_rand(&x) & 0xFFF);
+    }
+    t->table[WT_SIZE] = t->table[0];
+    t->interp = wt->interp;
+    t->step = WT_CHECK_STEP;
+
+    // One index per pass with the interrupts masked: the signal ISR uses the interpolator
+    // between passes, its state is saved and restored
+    for (uint32_t idx = 0; idx < WT_SIZE; idx++){
+        interp_hw_save_t save;
+        uint32_t irq = save_and_disable_interrupts();
+        interp_save(t->interp, &save);
+        t->interp->base[2] = (uintptr_t)t->table;
+        for (uint32_t alpha = 0; alpha < 256; alpha++){
+            uint32_t phase = (idx << (32 - WT_BITS)) | (alpha << WT_FRAC_SHIFT) | (rq_ref_rand(&x) & 0xFFFF);
+            uint32_t ref = phase;
+            t->interp->accum[0] = phase;
+            uint16_t code = wt_next(t);
+            if(code != wt_ref_next(t->table, &ref, t->step) || t->interp->accum[0] != ref)
+                bad++;
+        }
+        interp_restore(t->interp, &save);
+        restore_interrupts(irq);
+        *n += 256;
+    }
+    return bad;
+}
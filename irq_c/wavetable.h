@@ -0,0 +1,159 @@
+/**
+ * \file        wavetable.h
+ * \brief       Interpolated wavetable playback with the SIO interpolator.
+ * \details     A phase accumulator walks a table of WT_SIZE DAC codes at a fixed
+ * sample rate (WT_FS). The fractional bits of the phase are not discarded: the
+ * interpolator generates the address of the two adjacent entries and blends them,
+ * so each sample costs a few register accesses.
+ *
+ * Lane 0 (blend): index of the table, times 2 (16-bit codes) -> FULL result = table address.
+ * Lane 1 (cross input from accum 0): alpha -> lane 1 result = interpolated code.
+ *
+ * The blend mode only exists in the interp0 of each core, so only one wavetable can use the
+ * interpolator. The others are given no interpolator (NULL) and run the same algorithm in
+ * plain C, from wavetable_ref.h, with the phase in the structure.
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#ifndef __WAVETABLE_
+#define __WAVETABLE_
+
+#include <stdint.h>
+#include "hardware/interp.h"
+
+#include "wavetable_ref.h"
+#include "dsg_signal.h"
+#include "dac.h"
+
+/**
+ * @typedef wavetable_t
+ *
+ * @brief Structure to manage the interpolated playback of one period of a signal
+ *
+ */
+typedef struct{
+    uint16_t table[WT_SIZE + 1];    // DAC codes of one period, table[WT_SIZE] = table[0]
+    uint32_t q[WT_SIZE];            // Codes without the dither, for wt_redither()
+    uint32_t step;                  // Phase increment per sample
+    uint32_t phase;                 // Phase accumulator without interpolator
+    interp_hw_t *interp;            // interp0, or NULL for the software blend
+}wavetable_t;
+
+/**
+ * @brief Initialize the wavetable and configure the interpolator.
+ * The interpolator belongs to the core that calls this function.
+ *
+ * @param wt
+ * @param interp interp0 (interp1 has no blend mode), NULL for the software blend
+ * @param freq in Hz
+ */
+void wt_init(wavetable_t *wt, interp_hw_t *interp, uint32_t freq);
+
+/**
+ * @brief Fill the table with one period of the signal, already converted to DAC codes.
+ *
+ * @param wt
+ * @param signal
+ * @param dac   Its calibration is used to convert the values
+ */
+void wt_build(wavetable_t *wt, signal_t *signal, const dac_t *dac);
+
+/**
+ * @brief Compare the interpolator of the wavetable with wt_ref_next(): every index and alpha
+ * of the phase, with random low bits, on a table of random 12-bit codes (the last index
+ * blends with the guard entry). The phase after each code is compared too.
+ *
+ * @param wt    Its interpolator is used, its table and phase are not changed
+ * @param n     Codes compared
+ * @return uint32_t codes or phases that differ. 0 without interpolator
+ */
+uint32_t wt_check(const wavetable_t *wt, uint32_t *n);
+
+/**
+ * @brief Draw a new dither for the table, with DAC_REQ_TPDF. It is called from the main loop
+ * while the table is output.
+ *
+ * @param wt
+ * @param dac   The one the table was built with
+ */
+static inline void wt_redither(wavetable_t *wt, const dac_t *dac)
+{
+    dac_redither(dac, wt->q, wt->table, WT_SIZE);
+    wt->table[WT_SIZE] = wt->table[0];
+}
+
+/**
+ * @brief Set the output frequency. The phase is kept, so there is no jump.
+ *
+ * @param wt
+ * @param freq in Hz
+ */
+static inline void wt_set_freq(wavetable_t *wt, uint32_t freq)
+{
+    wt->step = wt_ref_step(freq);
+}
+
+/**
+ * @brief Phase accumulator of the wavetable
+ *
+ * @param wt
+ * @return uint32_t
+ */
+static inline uint32_t wt_phase(const wavetable_t *wt)
+{
+    return wt->interp ? wt->interp->accum[0] : wt->phase;
+}
+
+/**
+ * @brief Lock the phase of the wavetable to another one, plus an offset.
+ * Both must use the same step to stay locked.
+ *
+ * @param wt
+ * @param ref
+ * @param phase in degrees
+ */
+static inline void wt_sync(wavetable_t *wt, const wavetable_t *ref, uint16_t phase)
+{
+    uint32_t accum = wt_phase(ref) + (uint32_t)(((uint64_t)phase << 32)/360);
+    if(wt->interp)
+        wt->interp->accum[0] = accum;
+    else
+        wt->phase = accum;
+}
+
+/**
+ * @brief The next code is the first one of a period: the phase wraps between it and the last one.
+ *
+ * @param wt
+ * @return true
+ */
+static inline bool wt_period_start(const wavetable_t *wt)
+{
+    return wt_phase(wt) < wt->step;
+}
+
+/**
+ * @brief Get the next code and advance the phase.
+ *
+ * @param wt
+ * @return uint16_t
+ */
+static inline uint16_t wt_next(wavetable_t *wt)
+{
+    interp_hw_t *ip = wt->interp;
+    if(!ip)
+        return wt_ref_next(wt->table, &wt->phase, wt->step);
+
+    const uint16_t *pair = (const uint16_t *)ip->peek[2];
+
+    ip->base[0] = pair[0];
+    ip->base[1] = pair[1];
+    uint16_t code = (uint16_t)ip->peek[1];
+    ip->add_raw[0] = wt->step;
+    return code;
+}
+
+#endif // __WAVETABLE_
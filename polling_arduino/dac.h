@@ -13,6 +13,12 @@
 
 #include "api/Common.h"
 #include "api/Compat.h"
+#if defined(ARDUINO_ARCH_RP2040)
+#include "hardware/structs/sio.h"
+#define DAC_SIO     1           // Arduino-Pico core: the byte is written with one store to the SIO
+#else
+#define DAC_SIO     0           // Other cores: one digitalWrite() per bit
+#endif
 
 #define RESOLUTION  255         // 8 bits
 #define DAC_RANGE   10120        // 0 to 9.3V
@@ -62,6 +68,8 @@ void dac_init(dac_t *dac, uint8_t gpio_lsb, bool en)
 
 /**
  * @brief With BITS, output the signal.
+ * With DAC_SIO, the 8 bits change at the same time: the bits that differ from the current
+ * output are toggled through gpio_togl (the XOR alias of GPIO_OUT), the other GPIOs are kept.
  * 
  * @param dac 
  */
@@ -69,6 +77,9 @@ void dac_output(dac_t *dac)
 {
   if(!dac->en) return;
 
+#if DAC_SIO
+  sio_hw->gpio_togl = (sio_hw->gpio_out ^ ((uint32_t)(dac->digit_v & 0xFF) << dac->gpio_lsb)) & (0x000000FFu << dac->gpio_lsb);
+#else
   digitalWrite(dac->gpio_lsb + 0, dac->BITS.bit0);
   digitalWrite(dac->gpio_lsb + 1, dac->BITS.bit1);
   digitalWrite(dac->gpio_lsb + 2, dac->BITS.bit2);
@@ -77,7 +88,7 @@ void dac_output(dac_t *dac)
   digitalWrite(dac->gpio_lsb + 5, dac->BITS.bit5);
   digitalWrite(dac->gpio_lsb + 6, dac->BITS.bit6);
   digitalWrite(dac->gpio_lsb + 7, dac->BITS.bit7);
-    
+#endif
 }
 
 /**
@@ -90,6 +101,7 @@ void dac_calculate(dac_t *dac, int16_t decim_v)
 {
     
   dac->digit_v = (decim_v + (int16_t)DAC_BIAS + 5000)*RESOLUTION/DAC_RANGE ; // normalize to 8 bits
+#if !DAC_SIO
   dac->BITS.bit0 = (dac->digit_v & 0x01) >> 0;
   dac->BITS.bit1 = (dac->digit_v & 0x02) >> 1;
   dac->BITS.bit2 = (dac->digit_v & 0x04) >> 2;
@@ -98,6 +110,7 @@ void dac_calculate(dac_t *dac, int16_t decim_v)
   dac->BITS.bit5 = (dac->digit_v & 0x20) >> 5;
   dac->BITS.bit6 = (dac->digit_v & 0x40) >> 6;
   dac->BITS.bit7 = (dac->digit_v & 0x80) >> 7;
+#endif
 
   dac_output(dac);
 }
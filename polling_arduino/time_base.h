@@ -13,20 +13,46 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "pico/time.h"
 #include "hardware/timer.h"
 
-// typedef unsigned long uint64_t;
+#define TB_MIN_US   5   ///< Shortest period, the alarm interrupt itself takes a few us
 
 /** 
  * @typedef time_base_t
- * @brief this datatype enable the management of concurrent temporal events
+ * @brief this datatype enable the management of concurrent temporal events.
+ * Each time base has a repeating timer of the SDK: its alarm counts the events (fired) and
+ * the loop consumes them (done), so tb_check() does not read the time.
  */
 typedef struct {
-    uint64_t next;                          ///< Struct member with the time for the next temporal event
+    repeating_timer_t rt;                   ///< Repeating timer of the time base
+    volatile uint32_t fired;                ///< Events counted by the alarm
+    uint32_t done;                          ///< Events consumed by tb_next()
     uint64_t delta;                         ///< Struct member with the event period in us
+    bool run;                               ///< The repeating timer is running
     bool en;                               ///< Enabler of the time base
 }time_base_t;
 
+/**
+ * @brief Alarm of the repeating timer, in interrupt context
+ */
+static bool tb_alarm(repeating_timer_t *rt){
+    ((time_base_t *)rt->user_data)->fired++;
+    return true;
+}
+
+/**
+ * @brief (Re)start the repeating timer: the next event is one period from now
+ * @param t     pointer to temporal structure
+ */
+static inline void tb_start(time_base_t *t){
+    if(t->run)
+        cancel_repeating_timer(&t->rt);
+    t->done = t->fired;
+    // A negative delay keeps the period from one alarm to the next, not from the end of the callback
+    t->run = add_repeating_timer_us(-(int64_t)(t->delta < TB_MIN_US ? TB_MIN_US : t->delta), tb_alarm, t, &t->rt);
+}
+
 /**
  * @brief This method initialize the time base structure
  * @param t     pointer to temporal structure
@@ -34,9 +60,13 @@ typedef struct {
  * @param en    true if time base start enabled and false in other case
  */ 
 void tb_init(time_base_t *t, uint64_t us, bool en){
-    t->next = micros() + us ;
+    t->fired = 0;
+    t->done = 0;
     t->delta = us;
+    t->run = false;
     t->en = en;
+    if(en)
+        tb_start(t);
 }
 
 /**
@@ -46,34 +76,43 @@ void tb_init(time_base_t *t, uint64_t us, bool en){
  * @return     True if time base period had lapsed and False when it hasn't
  */ 
 static inline bool tb_check(time_base_t *t){
-    return (micros() >= t->next) && t->en;
+    return (t->fired != t->done) && t->en;
 }
 
 /// @brief update the tb to next temporal event with respect to the current time
 /// @param t time base data structure
 static inline void tb_update(time_base_t *t){
-    t->next = micros() + t->delta;
+    tb_start(t);
 }
 
 /// @brief update the tb to next temporal event with respect to the last temporal event
 /// @param t time base data structure
 static inline void tb_next(time_base_t *t){
-    t->next = t->next + t->delta;
+    t->done++;
 }
 
 /// @brief enable time base to generate temporal events
 /// @param t time base data structure
 static inline void tb_enable(time_base_t *t){
     t->en = true;
+    if(!t->run)
+        tb_start(t);
 }
 /// @brief disable time base, no events are generated with tb_check
 /// @param t time base data structure
 static inline void tb_disable(time_base_t *t){
     t->en = false;
+    if(t->run)
+        cancel_repeating_timer(&t->rt);
+    t->run = false;
 }
 
+/// @brief change the period, the repeating timer is restarted with it
+/// @param t time base data structure
 static inline void tb_set_delta(time_base_t *t, uint64_t delta){
     t->delta = delta;
+    if(t->run)
+        tb_start(t);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -40,11 +40,12 @@
 #include "hardware/gpio.h"
 
 #include "time_base.h"
-#include "keypad_polling.h"
+#include "dsg_task.h"
 #include "gpio_led.h"
-#include "gpio_button.h"
-#include "signal_generator.h"
-#include "dac.h"
+#include "dsg_keypad.h"
+#include "dsg_button.h"
+#include "dsg_signal.h"
+#include "dsg_dac.h"
 
 static inline bool checkNumber(uint8_t number){
     return (number >= 0 && number <= 9);
@@ -67,189 +68,260 @@ static inline bool checkOffset(uint32_t offset){
 }
 
 
-int main() {
-    
-    stdio_init_all();
-    // sleep_ms(5000);
-    printf("Hola!!!");
+#define KP_SEQ_US   2000        // Period of the row sequence of the keypad
+#define DBNC_US     100000      // Period of the debouncers
+#define BTN_POLL_US 2000        // Period to read the button while it is not pressed
 
-    // Initialize signal generator
-    uint8_t in_param_state = 0x00; // 0: Nothing, 1: Entering amp (A), 2: Entering offset (B), 3: Entering freq (C)
-    uint32_t param = 0; // This variable will store the value of any parameter that is being entered
-    uint8_t key_cont = 0;
-    signal_t my_signal;
-    signal_gen_init(&my_signal,1,1000,500,true);
+signal_t my_signal;
+dac_t my_dac;
+key_pad_t my_keypad;
+gpio_button_t my_button;
+time_base_t tb_signal;      // Sample time of the signal
+time_base_t tb_seq;         // Row sequence of the keypad
+time_base_t tb_kp_dbnce;    // Debouncer of the keypad
+time_base_t tb_btn_dbnce;   // Debouncer of the button
+time_base_t tb_print;
+sched_t my_sched;
 
-    // Initialize DAC
-    dac_t my_dac;
-    dac_init(&my_dac, 10, true);
-    signal_calculate(&my_signal);
-
-    // Initialize LED
-    uint8_t my_led = 18;
-    led_init(my_led);
-    cyw43_arch_init();
+// Tasks in priority order
+task_t tk_signal, tk_keypad, tk_button, tk_parser, tk_print;
 
-    // Initialize keypad and button
-    key_pad_t my_keypad;
-    kp_init(&my_keypad,2,6,100000,true);
+/**
+ * @brief Calculate the values of the signal and convert them to DAC codes, so the signal
+ * task only writes a code per sample.
+ */
+static void updateSignal(void)
+{
+    signal_calculate(&my_signal);
+    dac_codes(&my_dac, my_signal.arrayV, my_signal.arrayC, NULL, SAMPLE);
+}
 
-    gpio_button_t my_button;
-    button_init(&my_button, 0, 100000, true);
+/**
+ * @brief Output the next value of the signal at each event of its time base.
+ */
+static uint8_t signalTask(task_t *t)
+{
+    TK_BEGIN(t);
+    while(1){
+        TK_WAIT_TB(t, &tb_signal);
+        dac_output_codes(&my_dac, my_signal.arrayC[my_signal.cnt], 0);
+        my_signal.cnt = (my_signal.cnt + 1) % SAMPLE;
+    }
+    TK_END(t);
+}
 
-    // Initialize Printing
-    time_base_t tb_print;
-    tb_init(&tb_print,1000000,true);
-    
+/**
+ * @brief Scan the rows of the keypad, capture a key and wait until it is released.
+ * The columns are read from the GPIO sample of the pass.
+ */
+static uint8_t keypadTask(task_t *t)
+{
+    static uint32_t cols;
 
+    TK_BEGIN(t);
     while(1){
-        // Process keypad
-        uint32_t cols = gpio_get_all() & (0x0000003C0); // 0000 0100 0000
-        if(cols && !my_keypad.KEY.dbnc){
-            tb_disable(&my_keypad.tb_seq);
-            kp_capture(&my_keypad,cols);
-            tb_update(&my_keypad.tb_dbnce);
-            tb_enable(&my_keypad.tb_dbnce);
-            kp_set_zflag(&my_keypad);
-            my_keypad.KEY.dbnc = 1;
-        }
-        if(tb_check(&my_keypad.tb_seq)){
-            tb_next(&my_keypad.tb_seq);
+        // The row of the sequence has been driven for a whole period
+        TK_WAIT_TB(t, &tb_seq);
+        cols = kp_cols_of(&my_keypad, t->gpios);
+        if(!cols){
             kp_gen_seq(&my_keypad);
+            continue;
         }
-        if(tb_check(&my_keypad.tb_dbnce)){
-            tb_next(&my_keypad.tb_dbnce);
+        kp_capture(&my_keypad,cols);
+        my_keypad.KEY.dbnc = 1;
+        kp_set_zflag(&my_keypad);
+        tb_update_at(&tb_kp_dbnce, t->now);
+        tb_enable(&tb_kp_dbnce);
+
+        // Debouncer: the columns must be read as zero twice
+        while(1){
+            TK_WAIT_TB(t, &tb_kp_dbnce);
+            cols = kp_cols_of(&my_keypad, t->gpios);
             if(kp_is_2nd_zero(&my_keypad)){
-                if(!cols){
-                    // This able to generate seq only when a button is not pressed
-                    tb_update(&my_keypad.tb_seq); // It could happens that a button was pressed for a long time
-                    tb_enable(&my_keypad.tb_seq);
-                    tb_disable(&my_keypad.tb_dbnce);
-                    my_keypad.KEY.dbnc = 0;
-                }
-                else
-                    kp_clr_zflag(&my_keypad);
-            }
-            else{
                 if(!cols)
-                    kp_set_zflag(&my_keypad);
+                    break;
+                kp_clr_zflag(&my_keypad);
             }
+            else if(!cols)
+                kp_set_zflag(&my_keypad);
         }
-        // Process button
-        bool button = gpio_get(my_button.KEY.gpio_num);
-        if(button && !my_button.KEY.dbnc){
-            my_button.KEY.nkey = true; // This is a flag that indicates that a key was pressed
-            tb_update(&my_button.tb_dbnce); 
-            tb_enable(&my_button.tb_dbnce);
-            button_set_zflag(&my_button);
-            my_button.KEY.dbnc = 1;
+        tb_disable(&tb_kp_dbnce);
+        tb_update_at(&tb_seq, t->now); // It could happens that a button was pressed for a long time
+        my_keypad.KEY.dbnc = 0;
+        tk_notify(&tk_parser);
+    }
+    TK_END(t);
+}
+
+/**
+ * @brief Change the waveform when the button is released.
+ */
+static uint8_t buttonTask(task_t *t)
+{
+    static bool button;
+
+    TK_BEGIN(t);
+    while(1){
+        while(!button_of(&my_button, t->gpios)){
+            TK_DELAY(t, BTN_POLL_US);
         }
-        if(tb_check(&my_button.tb_dbnce)){
-            tb_next(&my_button.tb_dbnce);
+        my_button.KEY.nkey = true; // This is a flag that indicates that a key was pressed
+        my_button.KEY.dbnc = 1;
+        button_set_zflag(&my_button);
+        tb_update_at(&tb_btn_dbnce, t->now);
+        tb_enable(&tb_btn_dbnce);
+
+        while(1){
+            TK_WAIT_TB(t, &tb_btn_dbnce);
+            button = button_of(&my_button, t->gpios);
             if(button_is_2nd_zero(&my_button)){
-                if(!button){
-                    // printf("Button pressed\n");
-                    signal_set_state(&my_signal, (my_signal.STATE.ss + 1)%4);
-                    signal_calculate(&my_signal);
-                    tb_disable(&my_button.tb_dbnce);
-                    my_button.KEY.dbnc = 0;
-                }
-                else
-                    button_clr_zflag(&my_button);
-            }
-            else{
                 if(!button)
-                    button_set_zflag(&my_button);
+                    break;
+                button_clr_zflag(&my_button);
             }
+            else if(!button)
+                button_set_zflag(&my_button);
         }
-        // Process signal
-        if (tb_check(&my_signal.tb_gen)){
-            tb_next(&my_signal.tb_gen);
-            dac_calculate(&my_dac,my_signal.arrayV[my_signal.cnt]);
-            my_signal.cnt = (my_signal.cnt + 1) % SAMPLE;
-        }
+        tb_disable(&tb_btn_dbnce);
+        my_button.KEY.dbnc = 0;
+        my_button.KEY.nkey = false;
 
-        // Process printing
-        if(tb_check(&tb_print)){
-            tb_next(&tb_print);
-            switch (my_signal.STATE.ss){
-                case 0:
-                    printf("Sinusoidal: ");
-                    break;
-                case 1:
-                    printf("Triangular: ");
-                    break;
-                case 2:
-                    printf("Saw tooth: ");
-                    break;
-                case 3:
-                    printf("Square: ");
-                    break;
-            }
-            printf("Amp: %d, Offset: %d, Freq: %d\n", my_signal.amp, my_signal.offset, my_signal.freq);
+        signal_set_state(&my_signal, (my_signal.STATE.ss + 1)%4);
+        updateSignal();
+    }
+    TK_END(t);
+}
+
+/**
+ * @brief Parse the parameters entered with the keypad: a letter (A: amp, B: offset, 
+ * C: freq), the digits of the value and D to finalize.
+ */
+static uint8_t parserTask(task_t *t)
+{
+    static uint8_t key;
+    static uint8_t in_param_state; // 1: Entering amp (A), 2: Entering offset (B), 3: Entering freq (C)
+    static uint32_t param; // This variable will store the value of any parameter that is being entered
+
+    TK_BEGIN(t);
+    while(1){
+        // Only a letter different of 0x0D starts a parameter
+        TK_WAIT_EVENT(t, my_keypad.KEY.nkey && !my_keypad.KEY.dbnc);
+        key = my_keypad.KEY.dkey;
+        my_keypad.KEY.nkey = 0;
+        if(!checkLetter(key))
+            continue;
+        in_param_state = key - 0x09;
+        param = 0;
+        cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 1);
+
+        // Digits until 0x0D, the other letters are ignored
+        while(1){
+            TK_WAIT_EVENT(t, my_keypad.KEY.nkey && !my_keypad.KEY.dbnc);
+            key = my_keypad.KEY.dkey;
+            my_keypad.KEY.nkey = 0;
+            if(key == 0x0D)
+                break;
+            if(checkNumber(key))
+                param = param*10 + key;
         }
+        cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 0);
 
-        // Process entering parameters
-        if(my_keypad.KEY.nkey && !my_keypad.KEY.dbnc){
-            
-            // To accept a number, in_param_state must be different of 0
-            if(checkNumber(my_keypad.KEY.dkey) && in_param_state){
-                param = (!key_cont)? my_keypad.KEY.dkey : param*10 + my_keypad.KEY.dkey;
-                key_cont++;
+        switch (in_param_state)
+        {
+        case 1:
+            if(checkAmp(param)){
+                signal_set_amp(&my_signal,param);
             }
-            // To accept a letter different of 0x0D, in_param_state must be 0
-            else if(checkLetter(my_keypad.KEY.dkey) && !in_param_state){
-                cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 1);
-                // led_on(my_led);
-                switch (my_keypad.KEY.dkey)
-                {
-                case 0x0A:
-                    in_param_state = 1;
-                    break;
-                case 0x0B:
-                    in_param_state = 2;
-                    break;
-                case 0x0C:
-                    in_param_state = 3;
-                    break;
-                default:
-                    printf("Invalid letter\n");
-                    break;
-                }
+            break;
+        case 2:
+            if(checkOffset(param)){
+                signal_set_offset(&my_signal,param);
             }
-            // To accept a 0x0D, in_param_state must be different of 0
-            else if(my_keypad.KEY.dkey == 0x0D && in_param_state){
-                cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 0);
-                // led_off(my_led);
-                switch (in_param_state)
-                {
-                case 1:
-                    if(checkAmp(param)){
-                        signal_set_amp(&my_signal,param);
-                    }
-                    break;
-                case 2:
-                    if(checkOffset(param)){
-                        signal_set_offset(&my_signal,param);
-                    }
-                    break;
-                case 3:
-                    if(checkFreq(param)){
-                        signal_set_freq(&my_signal,param);
-                    }
-                    break;
-                default:
-                    printf("Invalid state\n");
-                    break;
-                }
-                signal_calculate(&my_signal);
-                in_param_state = 0;
-                param = 0;
-                key_cont = 0;
+            break;
+        case 3:
+            if(checkFreq(param)){
+                signal_set_freq(&my_signal,param);
+                tb_set_delta(&tb_signal,my_signal.t_sample);
             }
-            my_keypad.KEY.nkey = 0;
+            break;
+        }
+        updateSignal();
+    }
+    TK_END(t);
+}
+
+/**
+ * @brief Print the signal characteristics and the CPU share of the tasks every second.
+ */
+static uint8_t printTask(task_t *t)
+{
+    TK_BEGIN(t);
+    while(1){
+        TK_WAIT_TB(t, &tb_print);
+        switch (my_signal.STATE.ss){
+            case 0:
+                printf("Sinusoidal: ");
+                break;
+            case 1:
+                printf("Triangular: ");
+                break;
+            case 2:
+                printf("Saw tooth: ");
+                break;
+            case 3:
+                printf("Square: ");
+                break;
         }
+        printf("Amp: %d, Offset: %d, Freq: %d\n", my_signal.amp, my_signal.offset, my_signal.freq);
+        tk_report(&my_sched);
+    }
+    TK_END(t);
+}
+
+int main() {
+    
+    stdio_init_all();
+    // sleep_ms(5000);
+    printf("Hola!!!");
+
+    // Initialize signal generator
+    signal_gen_init(&my_signal,1,1000,500,true);
+    tb_init(&tb_signal,my_signal.t_sample,true);
+
+    // Initialize DAC, only the channel A
+    dac_init(&my_dac, &dac_parallel8, 10, NULL, true);
+    dac_set_range(&my_dac, 10000); // Output stage of this board
+    updateSignal();
+
+    // Initialize LED
+    uint8_t my_led = 18;
+    led_init(my_led);
+    cyw43_arch_init();
+
+    // Initialize keypad and button
+    kp_init(&my_keypad,2,6,true);
+    tb_init(&tb_seq,KP_SEQ_US,true);
+    tb_init(&tb_kp_dbnce,DBNC_US,false);
+    button_init(&my_button, 0, true);
+    tb_init(&tb_btn_dbnce,DBNC_US,false);
+
+    // Initialize Printing
+    tb_init(&tb_print,1000000,true);
+
+    // Budgets in us: the longest call of each task
+    tk_init(&my_sched);
+    tk_add(&my_sched, &tk_signal, "signal", signalTask, 5);
+    tk_add(&my_sched, &tk_keypad, "keypad", keypadTask, 10);
+    tk_add(&my_sched, &tk_button, "button", buttonTask, 600); // updateSignal()
+    tk_add(&my_sched, &tk_parser, "parser", parserTask, 600); // updateSignal()
+    tk_add(&my_sched, &tk_print, "print", printTask, 1000);
+
+    // The core sleeps until the next task, the signal task is not delayed by it.
+    // The print task reports the CPU share of the tasks and the period of the loop.
+    while(1){
+        if(!tk_run(&my_sched))
+            tk_sleep(&my_sched);
     }
 
     return 1;
-}
\ No newline at end of file
+}
@@ -21,4 +21,4 @@ void tb_init(time_base_t *t, uint64_t us, bool en){
     t->next = time_us_64() + us ;
     t->delta = us;
     t->en = en;
-}
\ No newline at end of file
+}
@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 #include "hardware/timer.h"
+
+#include "dsg_task.h"
 /** 
  * \typedef time_base_t
  * \brief this datatype enable the management of concurrent temporal events
@@ -63,4 +65,37 @@ static inline void tb_set_delta(time_base_t *t, uint64_t delta){
     t->delta = delta;
 }
 
+/**
+ * \brief Same as tb_check(), with a time already read
+ * \param t    Pointer to temporal structure
+ * \param now  Current time in us
+ */
+static inline bool tb_check_at(const time_base_t *t, uint64_t now){
+    return (now >= t->next) && t->en;
+}
+
+/// @brief Same as tb_update(), with a time already read
+/// @param t time base data structure
+/// @param now current time in us
+static inline void tb_update_at(time_base_t *t, uint64_t now){
+    t->next = now + t->delta;
+}
+
+/// @brief Wait for the next event of a time base and move it to the following one
+#define TK_WAIT_TB(t, tb)       do{ TK_WAIT_UNTIL(t, tk_tb_due(t, tb)); tb_next(tb); }while(0)
+
+/**
+ * \brief Check a time base at the time of the pass. If it is not due, the task sleeps 
+ * until its next event: the scheduler queue sorts the tasks by the next event of their 
+ * time bases.
+ * \param t    Task
+ * \param tb   Time base
+ */
+static inline bool tk_tb_due(task_t *t, time_base_t *tb){
+    if(tb_check_at(tb, t->now))
+        return true;
+    t->wake = tb->en ? tb->next : 0; // A disabled time base is checked in each pass
+    return false;
+}
+
 #endif
\ No newline at end of file
@@ -22,12 +22,12 @@
 #include "hardware/sync.h"
 
 #include "functs.h"
-#include "keypad.h"
-#include "gpio_led.h"
-#include "gpio_button.h"
-#include "signal_generator.h"
-#include "dac.h"
 #include "gpio_led.h"
+#include "dsg_task.h"
+#include "dsg_keypad.h"
+#include "dsg_button.h"
+#include "dsg_signal.h"
+#include "dsg_dac.h"
 
 
 key_pad_t gKeyPad; // Keypad object
@@ -35,17 +35,33 @@ signal_t gSignal; // Signal generator object
 gpio_button_t gButton; // Button object
 dac_t gDac; // DAC object
 uint8_t gLed = 18; // GPIO 18
+sched_t gSched; // Cooperative scheduler of the tasks
+task_t gTasks[5]; // signal, keypad, button, parser and print
+volatile uint32_t gSignalAlarm; // Time of the next alarm of the signal, written by its ISR
 
 volatile flags_t gFlags; // Global variable that stores the flags of the interruptions
 
+/**
+ * @brief Calculate the values of the signal and convert them to DAC codes, so the signal
+ * task only writes a code per sample.
+ */
+static void updateSignal(void)
+{
+    signal_calculate(&gSignal);
+    dac_codes(&gDac, gSignal.arrayV, gSignal.arrayC, NULL, SAMPLE);
+}
+
 void initGlobalVariables(void)
 {
     gFlags.W = 0x00U;
     kp_init(&gKeyPad,2,6,true);
+    kp_set_irq_callback(&gKeyPad, gpioCallback);
     signal_gen_init(&gSignal, 10, 1000, 500, true);
-    signal_calculate(&gSignal);
-    button_init(&gButton, 0);
-    dac_init(&gDac, 10, true);
+    button_init(&gButton, 0, true);
+    button_set_irq_callback(&gButton, gpioCallback);
+    dac_init(&gDac, &dac_parallel8, 10, NULL, true); // Only the channel A
+    dac_set_range(&gDac, 10120); // Output stage of this board
+    updateSignal();
     led_init(gLed);
 }
 
@@ -109,7 +125,7 @@ static inline void keypadCallback(uint num, uint32_t mask)
 {
     gFlags.B.keyFlag = true;
     // Capture the key pressed
-    uint32_t cols = gpio_get_all() & 0x000003C0; // Get columns gpio values
+    uint32_t cols = kp_get_cols(&gKeyPad); // Get columns gpio values
     kp_capture(&gKeyPad, cols);
     //printf("Key: %02x\n", gKeyPad.KEY.dkey);
 
@@ -136,7 +152,8 @@ static inline void buttonCallback(uint num, uint32_t mask)
     irq_set_exclusive_handler(TIMER_IRQ_0, timerSignalHandler);
     irq_set_enabled(TIMER_IRQ_0, true);
     hw_set_bits(&timer_hw->inte, 1u << TIMER_IRQ_0); // Enable alarm0 for signal value calculation
-    timer_hw->alarm[0] = (uint32_t)(time_us_64() + gSignal.t_sample); // Set alarm0 to trigger in t_sample
+    gSignalAlarm = (uint32_t)(time_us_64() + gSignal.t_sample);
+    timer_hw->alarm[0] = gSignalAlarm; // Set alarm0 to trigger in t_sample
 
     gFlags.B.signalFlag = true;
 
@@ -144,8 +161,8 @@ static inline void buttonCallback(uint num, uint32_t mask)
 
 static inline void timerSignalCallback(void)
  {
-    // Perform the signal value calculation and output to the DAC
-    dac_calculate(&gDac,gSignal.arrayV[gSignal.cnt]);
+    // Output the code of the next point to the DAC
+    dac_output_codes(&gDac, gSignal.arrayC[gSignal.cnt], 0);
     gSignal.cnt = (gSignal.cnt + 1)%SAMPLE;
     
  }
@@ -187,136 +204,174 @@ static inline void timerPrintCallback(void)
 
  }
 
-void program(void){
-    if(gFlags.B.keyFlag){
-        kp_set_zflag(&gKeyPad); // Set the flag that indicates that a zero was detected on keypad
-        gKeyPad.KEY.dbnc = 1;
-
-        //printf("Key: %02x\n", gKeyPad.KEY.dkey);
-
-        // Auxiliar variables
-        static uint8_t in_param_state = 0x00; // 0: Nothing, 1: Entering amp (A), 2: Entering offset (B), 3: Entering freq (C)
-        static uint32_t param = 0; // This variable will store the value of any parameter that is being entered
-        static uint8_t key_cont = 0;
-
+/**
+ * @brief Time of the next alarm of the signal in 64 bits. The ISR writes the 32 bits of the
+ * alarm in one store, they are widened with the time: the alarm is less than 2^31 us away.
+ */
+static uint64_t signalNext(void)
+{
+    uint64_t now = time_us_64();
+    return now + (int32_t)(gSignalAlarm - (uint32_t)now);
+}
 
-        // Process the key pressed 
+static uint8_t signalTask(task_t *t)
+{
+    TK_BEGIN(t);
+    while(1){
+        tk_wake_at(t, signalNext()); // The other tasks must fit before the next sample
+        TK_WAIT_UNTIL(t, gFlags.B.signalFlag);
+        gFlags.B.signalFlag = false;
+        timerSignalCallback();
+    }
+    TK_END(t);
+}
 
-        // To accept a number, in_param_state must be different of 0
-        if(checkNumber(gKeyPad.KEY.dkey) && in_param_state){
-            param = (!key_cont)? gKeyPad.KEY.dkey : param*10 + gKeyPad.KEY.dkey;
-            key_cont++;
-        }
-        // To accept a letter different of 0x0D, in_param_state must be 0
-        else if(checkLetter(gKeyPad.KEY.dkey) && !in_param_state){
-            // cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 1);
-            led_on(gLed);
-            switch (gKeyPad.KEY.dkey)
-            {
-            case 0x0A:
-                in_param_state = 1;
-                break;
-            case 0x0B:
-                in_param_state = 2;
-                break;
-            case 0x0C:
-                in_param_state = 3;
-                break;
-            default:
-                printf("Invalid letter\n");
-                break;
-            }
-        }
-        // To accept a 0x0D, in_param_state must be different of 0
-        else if(gKeyPad.KEY.dkey == 0x0D && in_param_state){
-            // cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 0);
-            led_off(gLed);
-            switch (in_param_state)
-            {
-            case 1:
-                if(checkAmp(param)){
-                    signal_set_amp(&gSignal,param);
-                }
-                break;
-            case 2:
-                if(checkOffset(param)){
-                    signal_set_offset(&gSignal,param);
-                }
-                break;
-            case 3:
-                if(checkFreq(param)){
-                    signal_set_freq(&gSignal,param);
-                }
-                break;
-            default:
-                printf("Invalid state\n");
-                break;
-            }
-            signal_calculate(&gSignal);
-            in_param_state = 0;
-            param = 0;
-            key_cont = 0;
-        }
-        gKeyPad.KEY.nkey = 0;
+static uint8_t keypadTask(task_t *t)
+{
+    static uint32_t cols;
 
+    TK_BEGIN(t);
+    while(1){
+        // The key was captured in the GPIO ISR, the parser task takes it
+        TK_WAIT_UNTIL(t, gFlags.B.keyFlag);
         gFlags.B.keyFlag = false;
-    }
-    if(gFlags.B.keyDbnc){
-        uint32_t cols;
-        cols = gpio_get_all() & 0x000003C0; // Get columns gpio values
-        if(kp_is_2nd_zero(&gKeyPad)){
-            if(!cols){
-                kp_set_irq_enabled(&gKeyPad, true); // Enable the GPIO IRQs
-                pwm_set_enabled(0, true);    // Enable the row sequence
-                pwm_set_enabled(1, false);   // Disable the keypad debouncer
-                gKeyPad.KEY.dbnc = 0;
-            }
-            else
+        kp_set_zflag(&gKeyPad); // Set the flag that indicates that a zero was detected on keypad
+        gKeyPad.KEY.dbnc = 1;
+
+        // Debouncer: the columns must be read as zero twice
+        while(1){
+            TK_WAIT_UNTIL(t, gFlags.B.keyDbnc);
+            gFlags.B.keyDbnc = false;
+            cols = kp_cols_of(&gKeyPad, t->gpios); // Columns of the GPIO sample of the pass
+            if(kp_is_2nd_zero(&gKeyPad)){
+                if(!cols)
+                    break;
                 kp_clr_zflag(&gKeyPad);
-        }
-        else{
-            if(!cols)
+            }
+            else if(!cols)
                 kp_set_zflag(&gKeyPad);
         }
-        gFlags.B.keyDbnc = false;
+        kp_set_irq_enabled(&gKeyPad, true); // Enable the GPIO IRQs
+        pwm_set_enabled(0, true);    // Enable the row sequence
+        pwm_set_enabled(1, false);   // Disable the keypad debouncer
+        gKeyPad.KEY.dbnc = 0;
     }
-    if(gFlags.B.buttonFlag){
+    TK_END(t);
+}
+
+static uint8_t buttonTask(task_t *t)
+{
+    static bool button;
+
+    TK_BEGIN(t);
+    while(1){
+        TK_WAIT_UNTIL(t, gFlags.B.buttonFlag);
+        gFlags.B.buttonFlag = false;
         pwm_set_enabled(2, true); // Enable the button debouncer
         button_set_irq_enabled(&gButton, false); // Disable the button IRQs
         button_set_zflag(&gButton); // Set the flag that indicates that a zero was detected on button
         gButton.KEY.dbnc = 1;
 
-        gFlags.B.buttonFlag = false;
-    }
-    if(gFlags.B.buttonDbnc){
-        bool button;
-        button = gpio_get(gButton.KEY.gpio_num);
-        if(button_is_2nd_zero(&gButton)){
-            if(!button){
-                signal_set_state(&gSignal, (gSignal.STATE.ss + 1)%4);
-                button_set_irq_enabled(&gButton, true); // Enable the GPIO IRQs
-                pwm_set_enabled(2, false);    // Disable the button debouncer
-                signal_calculate(&gSignal); // Recalculate the signal values
-                gButton.KEY.dbnc = 0;
-            }
-            else
+        while(1){
+            TK_WAIT_UNTIL(t, gFlags.B.buttonDbnc);
+            gFlags.B.buttonDbnc = false;
+            button = button_of(&gButton, t->gpios);
+            if(button_is_2nd_zero(&gButton)){
+                if(!button)
+                    break;
                 button_clr_zflag(&gButton);
-        }
-        else{
-            if(!button)
+            }
+            else if(!button)
                 button_set_zflag(&gButton);
         }
-
-        gFlags.B.buttonDbnc = false;
+        signal_set_state(&gSignal, (gSignal.STATE.ss + 1)%4);
+        button_set_irq_enabled(&gButton, true); // Enable the GPIO IRQs
+        pwm_set_enabled(2, false);    // Disable the button debouncer
+        updateSignal(); // Recalculate the signal values
+        gButton.KEY.dbnc = 0;
     }
-    if(gFlags.B.signalFlag){
-        timerSignalCallback();
-        gFlags.B.signalFlag = false;
+    TK_END(t);
+}
+
+static uint8_t parserTask(task_t *t)
+{
+    static uint8_t key;
+    static uint8_t in_param_state; // 1: Entering amp (A), 2: Entering offset (B), 3: Entering freq (C)
+    static uint32_t param; // This variable will store the value of any parameter that is being entered
+
+    TK_BEGIN(t);
+    while(1){
+        // Only a letter different of 0x0D starts a parameter
+        TK_WAIT_UNTIL(t, gKeyPad.KEY.nkey);
+        key = gKeyPad.KEY.dkey;
+        gKeyPad.KEY.nkey = 0;
+        if(!checkLetter(key))
+            continue;
+        in_param_state = key - 0x09;
+        param = 0;
+        led_on(gLed);
+
+        // Digits until 0x0D, the other letters are ignored
+        while(1){
+            TK_WAIT_UNTIL(t, gKeyPad.KEY.nkey);
+            key = gKeyPad.KEY.dkey;
+            gKeyPad.KEY.nkey = 0;
+            if(key == 0x0D)
+                break;
+            if(checkNumber(key))
+                param = param*10 + key;
+        }
+        led_off(gLed);
+
+        switch (in_param_state)
+        {
+        case 1:
+            if(checkAmp(param)){
+                signal_set_amp(&gSignal,param);
+            }
+            break;
+        case 2:
+            if(checkOffset(param)){
+                signal_set_offset(&gSignal,param);
+            }
+            break;
+        case 3:
+            if(checkFreq(param)){
+                signal_set_freq(&gSignal,param);
+            }
+            break;
+        }
+        updateSignal();
     }
-    if(gFlags.B.printFlag){
-        timerPrintCallback();
+    TK_END(t);
+}
+
+static uint8_t printTask(task_t *t)
+{
+    TK_BEGIN(t);
+    while(1){
+        TK_WAIT_UNTIL(t, gFlags.B.printFlag);
         gFlags.B.printFlag = false;
+        timerPrintCallback();
+        tk_report(&gSched);
     }
+    TK_END(t);
+}
+
+void initTasks(void)
+{
+    // Priority order, budgets in us: the longest call of each task
+    tk_init(&gSched);
+    tk_add(&gSched, &gTasks[0], "signal", signalTask, 5);
+    tk_add(&gSched, &gTasks[1], "keypad", keypadTask, 10);
+    tk_add(&gSched, &gTasks[2], "button", buttonTask, 600); // updateSignal()
+    tk_add(&gSched, &gTasks[3], "parser", parserTask, 600); // updateSignal()
+    tk_add(&gSched, &gTasks[4], "print", printTask, 1000);
+}
+
+bool runTasks(void)
+{
+    return tk_run(&gSched);
 }
 
 bool check(){
@@ -67,10 +67,19 @@ void timerSignalHandler(void);
 void timerPrintHandler(void);
 
 /**
- * @brief This function is the main, here the program is executed when a flag of interruption is pending.
+ * @brief This function creates the tasks that process the flags of interruption: signal, keypad, 
+ * button, parser of the parameters and print. They are run by a cooperative scheduler.
  * 
  */
-void program(void);
+void initTasks(void);
+
+/**
+ * @brief This function runs one pass of the scheduler.
+ * 
+ * @return true When a task yielded, it must be run again before sleeping
+ * @return false When all the tasks are waiting
+ */
+bool runTasks(void);
 
 /**
  * @brief This function checks if there are a flag of interruption pending for execute the program.
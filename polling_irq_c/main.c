@@ -66,10 +66,11 @@ int main() {
     irq_set_exclusive_handler(PWM_IRQ_WRAP,pwmIRQ);
     irq_set_priority(PWM_IRQ_WRAP, 0xC0);
 
+    // Tasks that process the flags set by the interruptions.
+    initTasks();
+
     while(1){
-        while(check()){
-            program();
-        }
+        while(runTasks() || check());
         __wfi(); // Wait for interrupt (Will put the processor into deep sleep until woken by the RTC interrupt)
     }
 }
\ No newline at end of file
@@ -3,49 +3,118 @@
  - ``Author``:  MST_CDA
  - ``Version``:  1.0
  - ``Date``:  2024-04-14
- - ``Description``: This module define a class to impress the DAC (8bits)
+ - ``Description``: This module define a class to impress the DAC (8bits) with the PIO and the DMA
 """
 
+import rp2
+import machine
+import uctypes
+from array import array
 from machine import Pin
 
 RESOLUTION = 255        # 8 bits
-DAC_RANGE = 9400        # 0 to 9.3V
+DAC_RANGE = 10120       # Span in mV of the output stage: code 0 is -4.94 V, code 255 is +5.18 V
+DAC_BIAS = -60          # Offset in mV of the output stage, as in the C variants
+DAC_SM = 0              # State machine of PIO0 that outputs the codes
+DREQ_PIO0_TX0 = 0       # DREQ of the TX FIFO of the state machine 0
+DMA_BASE = 0x50000000   # DMA registers
+DMA_CH_STRIDE = 0x40    # Registers of each channel
+AL3_READ_ADDR_TRIG = 0x3C # Read address of a channel, it also triggers the channel
+SM_LOOP = 3             # Cycles of the loop of dac_out with a zero delay
+
+@rp2.asm_pio(out_init=(rp2.PIO.OUT_LOW,)*8, out_shiftdir=rp2.PIO.SHIFT_RIGHT, autopull=True, pull_thresh=8)
+def dac_out():
+    # Output one code each y + 3 cycles, the codes come from the TX FIFO (autopull)
+    out(pins, 8)
+    mov(x, y)
+    label("delay")
+    jmp(x_dec, "delay")
 
 class DAC:
     """
     Class to impress the DAC (8bits).
+    The period of the signal is a bytearray of codes. A state machine outputs them with
+    ``out pins, 8`` and two DMA channels feed it in a ring: the data channel copies the codes
+    to the TX FIFO and chains to the control channel, which writes the address of the codes
+    again in the data channel and restarts it. The interpreter only loads the codes and sets
+    the rate.
     """
     en: bool                # Enable the DAC processing
-    gpioD = []   # The eight gpios for the DAC
     lsb: int                # The LSB position for the DAC, the eight gpios must be consecutives.
-    digit_v: int            # The digit value for the DAC
+    codes: bytearray        # Codes of one period of the signal
+    addr: array             # Address of the codes, read by dma_ctrl
+    rate: int               # Samples per second
+    sm: rp2.StateMachine    # State machine that outputs the codes
+    dma_data: rp2.DMA       # Copies the codes to the state machine
+    dma_ctrl: rp2.DMA       # Restarts dma_data at the start of the codes
 
-    def __init__(self, lsb: int, en: bool):
+    def __init__(self, lsb: int, n: int, en: bool):
         """
         Constructor for DAC.
 
         Parameters:
         - ``lsb`` The LSB position for the DAC, the eight gpios must be consecutives.
+        - ``n`` Number of samples of one period.
         - ``en`` Enable DAC processing.
         """
         # Initialize the DAC variables
         self.en = en
         self.lsb = lsb
-        # Initialize the DAC gpios
-        for i in range(8):
-            self.gpioD.append(Pin(lsb + i, Pin.OUT)) 
+        self.rate = 0
+        self.codes = bytearray(n)
+        self.addr = array("I", [uctypes.addressof(self.codes)])
+        self.sm = None
+        self.dma_data = rp2.DMA()
+        self.dma_ctrl = rp2.DMA()
+
+    def load(self, values):
+        """
+        Convert the values of one period to codes. The DMA reads them in place, the new
+        period is output from the next sample.
+
+        Parameters:
+        - ``values`` The values in mV, as many as samples.
+        """
+        for i in range(len(self.codes)):
+            self.codes[i] = ((values[i] + DAC_BIAS + 5000)*RESOLUTION//DAC_RANGE) & 0xFF
 
-    def set_dac(self, value: int):
+    def set_rate(self, rate: int):
         """
-        Set the DAC value.
+        Set the samples per second and (re)start the output. The state machine runs at
+        clk_sys, the delay of each sample is counted in its cycles.
 
         Parameters:
-        - ``value`` The value to be set in the DAC.
+        - ``rate`` Samples per second.
         """
         if not self.en:
             return
 
-        self.digit_v = (value + 5000)*RESOLUTION//DAC_RANGE
-        for i in range(8):
-            self.gpioD[i].value(self.digit_v % 2)
-            self.digit_v = self.digit_v // 2
+        self.rate = rate
+        self.dma_ctrl.active(0)
+        self.dma_data.active(0)
+        if self.sm:
+            self.sm.active(0)
+
+        # The delay is loaded in y, then the OSR is emptied so the first out takes a code
+        clk = machine.freq()
+        delay = max(clk//rate - SM_LOOP, 0)
+        self.sm = rp2.StateMachine(DAC_SM, dac_out, freq=clk, out_base=Pin(self.lsb))
+        self.sm.put(delay)
+        self.sm.exec("pull()")
+        self.sm.exec("mov(y, osr)")
+        self.sm.exec("out(null, 32)")
+        self.sm.active(1)
+
+        self.dma_data.config(read=self.codes, write=self.sm, count=len(self.codes),
+            ctrl=self.dma_data.pack_ctrl(size=0, inc_write=False, treq_sel=DREQ_PIO0_TX0,
+            chain_to=self.dma_ctrl.channel), trigger=False)
+        self.dma_ctrl.config(read=self.addr,
+            write=DMA_BASE + self.dma_data.channel*DMA_CH_STRIDE + AL3_READ_ADDR_TRIG, count=1,
+            ctrl=self.dma_ctrl.pack_ctrl(size=2, inc_read=False, inc_write=False), trigger=True)
+
+    def get_freq(self) -> float:
+        """
+        Get the samples per second actually output: the delay is a whole number of cycles.
+        """
+        clk = machine.freq()
+        return clk/max(clk//self.rate, SM_LOOP)
@@ -7,8 +7,6 @@
 """
 
 from math import sin, pi
-from utime import ticks_us
-from time_base import Time_base
 
 S_TO_US = 1000000
 US_TO_S = 0.000001
@@ -23,7 +21,6 @@ class Signal:
     value: int          # Current value in mV
     arrayV = [] # Array of values for the signal
     cnt: int            # Counter for the signal
-    tb_gen: Time_base   # Time base for the signal generator
 
     def __init__(self, freq: int, amp: int, offset: int, en: bool):
         """
@@ -42,7 +39,6 @@ class Signal:
         self.offset = offset
         self.value = 0
         self.cnt = 0
-        self.tb_gen = Time_base(S_TO_US // (SAMPLE*freq), True)
         for i in range(SAMPLE):
             self.arrayV.append(0)
 
@@ -130,7 +126,6 @@ class Signal:
         - ``freq`` Frequency in Hz.
         """
         self.freq = freq
-        self.tb_gen.set_delta(S_TO_US // (SAMPLE*freq))
 
     def set_amp(self, amp: int):
         """
@@ -1,26 +1,237 @@
+/**
+ * \file        main.c
+ * \brief       Streaming player of the DAC: the host sends the codes through the USB.
+ * \details     The codes are read in blocks (stdio_usb.in_chars()) into a ring buffer and
+ * output on the GPIOs 10 to 17 by the wrap interrupt of a PWM slice, at the sample rate set by
+ * the host. There is no echo.
+ *
+ * Commands (one line each, answered with one line):
+ *  - `rate <Hz>`   Sample rate, the one obtained is answered
+ *  - `play <n>`    The next n bytes are codes (64 bits); the output starts when the ring is half full
+ *  - `stats`       Rate, codes played, level of the ring, underruns and overruns. The commands are
+ *                  only read between two play, so a long stream is sent in several play to read
+ *                  the stats meanwhile; the output continues while the ring has codes.
+ *  - `stop`        Stop the output and empty the ring
+ *
+ * An underrun is a sample time with the ring empty while a stream is being received (the last
+ * code is held). An overrun is a read where the ring was full with bytes waiting in the USB:
+ * the bytes are not lost, the host is slowed down by the flow control of the USB.
+ *
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
 #include <stdio.h>
-#include "hardware/gpio.h"
+#include <stdlib.h>
+#include <string.h>
 #include "pico/stdlib.h"
-#include "hardware/uart.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
 #include "pico/binary_info.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+
+#define DAC_LSB         10              // GPIOs 10 to 17
+#define DAC_MASK        (0x000000FFu << DAC_LSB)
+#define RING_BITS       14
+#define RING_SIZE       (1u << RING_BITS) // 16 KiB
+#define RING_MASK       (RING_SIZE - 1)
+#define PLAY_SLICE      0               // PWM slice used as the sample clock, its GPIOs are not used
+#define PLAY_MAX_RATE   250000          // The interrupt and the USB share the core
+#define PLAY_RATE       8000            // Default sample rate
+#define CMD_LEN         32
+
+static uint8_t gRing[RING_SIZE];
+static volatile uint32_t gHead;         // Codes written by the main loop (free running)
+static volatile uint32_t gTail;         // Codes output by the interrupt (free running)
+static volatile bool gPlaying;          // The sample clock is running
+static volatile bool gStreaming;        // Codes of a play command are still expected
+static uint64_t gRemaining;             // Codes of the play command not received yet
+static uint32_t gRate;                  // Sample rate obtained
+static volatile uint32_t gPlayed;
+static volatile uint32_t gUnderrun;
+static uint32_t gOverrun;
+static bool gFull;                      // The ring is full, counted once in gOverrun
+
+static char gCmd[CMD_LEN];
+static uint8_t gCmdLen;
+
+/**
+ * @brief Wrap of the PWM slice: output the next code.
+ */
+static void __not_in_flash_func(playHandler)(void)
+{
+    pwm_clear_irq(PLAY_SLICE);
+    uint32_t tail = gTail;
+    if(tail != gHead){
+        gpio_put_masked(DAC_MASK, (uint32_t)gRing[tail & RING_MASK] << DAC_LSB);
+        gTail = tail + 1;
+        gPlayed++;
+    }
+    else if(gStreaming){
+        gUnderrun++; // The last code is held
+    }
+    else{
+        pwm_set_enabled(PLAY_SLICE, false); // End of the stream
+        gPlaying = false;
+    }
+}
+
+/**
+ * @brief Set the sample rate: clk_sys/(div*(wrap + 1)), the divider is the smallest that fits
+ * the wrap in 16 bits.
+ *
+ * @param rate in Hz
+ * @return uint32_t The rate obtained
+ */
+static uint32_t setRate(uint32_t rate)
+{
+    uint32_t clk = clock_get_hz(clk_sys);
+
+    if(rate < 1)
+        rate = 1;
+    if(rate > PLAY_MAX_RATE)
+        rate = PLAY_MAX_RATE;
+    uint32_t cycles = clk/rate;
+    uint32_t div = cycles/65536 + 1;
+    if(div > 255)
+        div = 255;
+    uint32_t wrap = cycles/div - 1;
+    if(wrap > 0xFFFF)
+        wrap = 0xFFFF;
+    pwm_set_clkdiv_int_frac(PLAY_SLICE, div, 0);
+    pwm_set_wrap(PLAY_SLICE, wrap);
+    return clk/(div*(wrap + 1));
+}
+
+/**
+ * @brief Stop the output and empty the ring.
+ */
+static void stopPlay(void)
+{
+    pwm_set_enabled(PLAY_SLICE, false);
+    gPlaying = false;
+    gStreaming = false;
+    gRemaining = 0;
+    gTail = gHead;
+}
+
+/**
+ * @brief Execute a command line.
+ *
+ * @param cmd
+ */
+static void runCommand(char *cmd)
+{
+    char *arg = strchr(cmd, ' ');
+    if(arg)
+        *arg++ = '\0';
+
+    if(!strcmp(cmd, "rate") && arg){
+        gRate = setRate(strtoul(arg, NULL, 10));
+        printf("ok rate %lu\n", (unsigned long)gRate);
+    }
+    else if(!strcmp(cmd, "play") && arg){
+        gRemaining = strtoull(arg, NULL, 10);
+        gStreaming = gRemaining > 0;
+        printf("ok play %llu\n", (unsigned long long)gRemaining);
+    }
+    else if(!strcmp(cmd, "stats")){
+        printf("rate %lu played %lu level %lu underrun %lu overrun %lu\n", (unsigned long)gRate,
+            (unsigned long)gPlayed, (unsigned long)(gHead - gTail), (unsigned long)gUnderrun,
+            (unsigned long)gOverrun);
+    }
+    else if(!strcmp(cmd, "stop")){
+        stopPlay();
+        printf("ok stop\n");
+    }
+    else if(cmd[0]){
+        printf("error %s\n", cmd);
+    }
+}
+
+/**
+ * @brief Read the codes of the current play command into the ring, in blocks.
+ */
+static void readCodes(void)
+{
+    uint32_t level = gHead - gTail;
+
+    if(level == RING_SIZE){
+        if(!gFull && tud_cdc_available())
+            gOverrun++;
+        gFull = true;
+        return;
+    }
+    gFull = false;
+    // The contiguous part of the free space, up to the end of the ring
+    uint32_t head = gHead & RING_MASK;
+    uint32_t n = RING_SIZE - level;
+    if(n > RING_SIZE - head)
+        n = RING_SIZE - head;
+    if(n > gRemaining)
+        n = (uint32_t)gRemaining;
+    int res = stdio_usb.in_chars((char *)&gRing[head], n);
+    if(res <= 0)
+        return;
+    n = res;
+    gHead += n;
+    gRemaining -= n;
+    if(!gRemaining)
+        gStreaming = false;
+}
+
+/**
+ * @brief Read a command line, one byte at a time: the codes that follow a play command must
+ * not be read here.
+ */
+static void readCommand(void)
+{
+    char c;
+
+    while(!gRemaining && stdio_usb.in_chars(&c, 1) == 1){
+        if(c == '\r')
+            continue;
+        if(c == '\n'){
+            gCmd[gCmdLen] = '\0';
+            gCmdLen = 0;
+            runCommand(gCmd);
+        }
+        else if(gCmdLen < CMD_LEN - 1){
+            gCmd[gCmdLen++] = c;
+        }
+    }
+}
 
 int main() {
     stdio_init_all();
-    
-    // Configurar pines GPIO
-    for (int i = 10; i <= 17; i++) {
-        gpio_init(i);
-        gpio_set_dir(i, GPIO_OUT);
-    }
-    
+    bi_decl(bi_program_description("DAC streaming player: codes from the USB to GPIOs 10 to 17"));
+
+    gpio_init_mask(DAC_MASK);
+    gpio_set_dir_masked(DAC_MASK, DAC_MASK);
+
+    gRate = setRate(PLAY_RATE);
+    pwm_clear_irq(PLAY_SLICE);
+    pwm_set_irq_enabled(PLAY_SLICE, true);
+    irq_set_exclusive_handler(PWM_IRQ_WRAP, playHandler);
+    irq_set_priority(PWM_IRQ_WRAP, 0);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
+
     while (true) {
-        // Leer dato del puerto serie
-        uint8_t data = getchar();
-        printf("Dato recibido: %d\n", data);
-        
-        // Colocar el dato en los pines GPIO 10 al 17
-        for (int i = 0; i < 8; i++) {
-            gpio_put(10 + i, (data >> i) & 0x01);
+        if(gRemaining)
+            readCodes();
+        else
+            readCommand();
+
+        // Prefill: the output starts with half the ring, or with a shorter whole stream
+        if(!gPlaying && gHead != gTail && (gHead - gTail >= RING_SIZE/2 || !gStreaming)){
+            gPlaying = true;
+            pwm_set_counter(PLAY_SLICE, 0);
+            pwm_set_enabled(PLAY_SLICE, true);
         }
     }
     return 0;
@@ -0,0 +1,523 @@
+/**
+ * \file        dsg_play.cpp
+ * \brief       Host player of WAV/CSV files through the streaming testDAC.
+ * \details     The file is memory mapped and read sequentially, so its size is not limited by
+ * the RAM. The samples are resampled (linear interpolation) to the output rate, converted to mV
+ * and quantized with dac_code() of dsg_core, the same transfer as the firmware. The codes
+ * are sent with the `rate`/`play` commands of testDAC in large writes, one `play` per second of
+ * codes; the USB flow control blocks the writes when the ring of the board is full. Between two
+ * `play` the board answers `stats`, so the sustained throughput and the underruns of the board
+ * are printed while streaming, and again at the end.
+ *
+ * When the output is not a terminal (a regular file, a pipe), only the codes are written.
+ *
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+extern "C" {
+#include "dsg_hal.h"
+#include "dsg_dac.h"
+}
+
+#define PLAY_RING       16384           // Ring of testDAC, in codes
+#define PLAY_MAX_RATE   250000          // Highest rate of testDAC
+#define PLAY_CHUNK      65536           // Codes per write
+#define PLAY_TIMEOUT_MS 2000            // Answer of a command
+
+using Clock = std::chrono::steady_clock;
+
+// ------------------------------------------------------------------
+// ----------------------------- Input ------------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Read-only memory map of a whole file.
+ */
+struct MappedFile {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    bool open(const char *path)
+    {
+        int fd = ::open(path, O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat st;
+        if(fstat(fd, &st) < 0 || st.st_size == 0){
+            ::close(fd);
+            return false;
+        }
+        void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(p == MAP_FAILED)
+            return false;
+        madvise(p, st.st_size, MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t *>(p);
+        size = st.st_size;
+        return true;
+    }
+
+    ~MappedFile()
+    {
+        if(data)
+            munmap(const_cast<uint8_t *>(data), size);
+    }
+};
+
+/**
+ * @brief Sequential source of samples in mV.
+ */
+struct Source {
+    double rate = 0;        // Samples per second
+    uint64_t frames = 0;    // Number of samples
+
+    virtual ~Source() {}
+    virtual bool next(double &mv) = 0;
+};
+
+/**
+ * @brief PCM (8, 16, 24, 32 bits) or float (32, 64 bits) WAV. Full scale is +-amp around offset.
+ */
+struct WavSource : Source {
+    const uint8_t *p = nullptr;
+    const uint8_t *end = nullptr;
+    unsigned bytes = 0;     // Bytes per sample
+    unsigned stride = 0;    // Bytes per frame
+    bool fp = false;
+    double amp = 0, offset = 0;
+
+    bool open(const MappedFile &f, unsigned channel, double a, double o, std::string &err)
+    {
+        const uint8_t *d = f.data;
+        if(f.size < 12 || memcmp(d, "RIFF", 4) || memcmp(d + 8, "WAVE", 4)){
+            err = "not a RIFF/WAVE file";
+            return false;
+        }
+        unsigned fmt = 0, channels = 0, bits = 0;
+        size_t pos = 12;
+        while(pos + 8 <= f.size){
+            uint32_t len = rd32(d + pos + 4);
+            const uint8_t *c = d + pos + 8;
+            if(!memcmp(d + pos, "fmt ", 4) && len >= 16){
+                fmt = rd16(c);
+                channels = rd16(c + 2);
+                rate = rd32(c + 4);
+                bits = rd16(c + 14);
+                if(fmt == 0xFFFE && len >= 26)
+                    fmt = rd16(c + 24); // WAVE_FORMAT_EXTENSIBLE: first bytes of the subformat
+            }
+            else if(!memcmp(d + pos, "data", 4)){
+                p = c;
+                end = c + std::min<size_t>(len, f.size - pos - 8);
+                break;
+            }
+            pos += 8 + len + (len & 1);
+        }
+        if(!p || !channels || !rate){
+            err = "no fmt or data chunk";
+            return false;
+        }
+        fp = fmt == 3;
+        if((fmt != 1 && fmt != 3) || (fp && bits != 32 && bits != 64) || (!fp && (bits < 8 || bits > 32 || bits % 8))){
+            err = "unsupported format " + std::to_string(fmt) + ", " + std::to_string(bits) + " bits";
+            return false;
+        }
+        if(channel >= channels){
+            err = "the file has " + std::to_string(channels) + " channels";
+            return false;
+        }
+        bytes = bits/8;
+        stride = bytes*channels;
+        frames = (end - p)/stride;
+        end = p + frames*stride;
+        p += channel*bytes;
+        amp = a;
+        offset = o;
+        return true;
+    }
+
+    bool next(double &mv) override
+    {
+        if(p >= end)
+            return false;
+        double x;
+        if(fp){
+            if(bytes == 4){
+                float v;
+                memcpy(&v, p, 4);
+                x = v;
+            }
+            else{
+                memcpy(&x, p, 8);
+            }
+        }
+        else if(bytes == 1){
+            x = (p[0] - 128)/128.0; // 8 bits are unsigned
+        }
+        else{
+            int32_t v = 0;
+            for(unsigned i = 0; i < bytes; i++)
+                v |= (int32_t)p[i] << (8*i + 32 - 8*bytes); // Left aligned, sign in bit 31
+            x = v/2147483648.0;
+        }
+        p += stride;
+        mv = offset + amp*x;
+        return true;
+    }
+
+    static uint16_t rd16(const uint8_t *b) { return b[0] | b[1] << 8; }
+    static uint32_t rd32(const uint8_t *b) { return rd16(b) | (uint32_t)rd16(b + 2) << 16; }
+};
+
+/**
+ * @brief One sample in mV per line, in a column separated by commas, semicolons or tabs.
+ * The lines without a number in the column (header, comments) are skipped.
+ */
+struct CsvSource : Source {
+    const char *p = nullptr;
+    const char *end = nullptr;
+    unsigned column = 0;
+
+    void open(const MappedFile &f, unsigned col, double r)
+    {
+        p = reinterpret_cast<const char *>(f.data);
+        end = p + f.size;
+        column = col;
+        rate = r;
+        // First pass to know the length of the stream: the map is read again from the page cache
+        const char *s = p;
+        double v;
+        while(s < end){
+            const char *eol = line(s, v);
+            frames += eol != nullptr;
+            s = nextLine(s);
+        }
+    }
+
+    bool next(double &mv) override
+    {
+        while(p < end){
+            const char *s = p;
+            p = nextLine(p);
+            if(line(s, mv))
+                return true;
+        }
+        return false;
+    }
+
+    const char *nextLine(const char *s) const
+    {
+        const char *nl = static_cast<const char *>(memchr(s, '\n', end - s));
+        return nl ? nl + 1 : end;
+    }
+
+    // Value of the column in the line that starts in s, nullptr if there is none
+    const char *line(const char *s, double &v) const
+    {
+        const char *eol = nextLine(s);
+        for(unsigned c = 0; c < column && s < eol; s++){
+            if(*s == ',' || *s == ';' || *s == '\t')
+                c++;
+        }
+        while(s < eol && (*s == ' ' || *s == '\t'))
+            s++;
+        if(s < eol && *s == '+')
+            s++;
+        auto res = std::from_chars(s, eol, v);
+        return res.ec == std::errc() ? eol : nullptr;
+    }
+};
+
+// ------------------------------------------------------------------
+// ---------------------- Resample and quantize ---------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Linear interpolation from the rate of the source to the output rate, in 32.32 fixed
+ * point, and quantization with dac_code(). The number of codes is known from the start.
+ */
+struct Converter {
+    Source &src;
+    dac_t dac;
+    uint64_t step;          // Input samples per output sample, 32.32
+    uint64_t frac = 0;
+    double s0 = 0, s1 = 0;
+    uint64_t total = 0;     // Codes of the stream
+    uint64_t clipped = 0;
+    int32_t lo, hi;         // mV that fit in the 8-bit codes
+
+    Converter(Source &s, double out_rate, uint16_t range) : src(s)
+    {
+        dac_init(&dac, &dac_parallel8, 0, nullptr, true);
+        dac_set_range(&dac, range);
+        step = (uint64_t)llround(src.rate*4294967296.0/out_rate);
+        if(!step)
+            step = 1;
+        if(src.frames){
+            total = (uint64_t)(((unsigned __int128)(src.frames - 1) << 32)/step) + 1;
+            src.next(s0);
+            if(!src.next(s1))
+                s1 = s0;
+        }
+        // Edges of the intervals of the codes 0 and RESOLUTION of the nominal transfer
+        lo = 0 - 5000 - DAC_BIAS;
+        hi = (int32_t)((RESOLUTION + 1)*(uint32_t)range/RESOLUTION) - 5000 - DAC_BIAS - 1;
+    }
+
+    uint8_t next()
+    {
+        double v = s0 + (s1 - s0)*(frac*(1.0/4294967296.0));
+        frac += step;
+        while(frac >= (1ull << 32)){
+            frac -= 1ull << 32;
+            s0 = s1;
+            if(!src.next(s1))
+                s1 = s0; // Hold the last sample
+        }
+        int32_t mv = (int32_t)lround(v);
+        if(mv < lo || mv > hi){
+            clipped++;
+            mv = mv < lo ? lo : hi;
+        }
+        return (uint8_t)dac_code(&dac, (int16_t)mv);
+    }
+};
+
+// ------------------------------------------------------------------
+// ----------------------------- Output -----------------------------
+// ------------------------------------------------------------------
+
+static bool setRaw(int fd)
+{
+    struct termios tio;
+    if(tcgetattr(fd, &tio) < 0)
+        return false;
+    cfmakeraw(&tio);
+    cfsetspeed(&tio, B115200); // Ignored by the USB CDC
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+static bool writeAll(int fd, const void *buf, size_t n)
+{
+    const uint8_t *b = static_cast<const uint8_t *>(buf);
+    while(n){
+        ssize_t w = write(fd, b, n);
+        if(w < 0)
+            return false;
+        b += w;
+        n -= w;
+    }
+    return true;
+}
+
+// Send a command and read its answer line
+static std::string command(int fd, const std::string &cmd)
+{
+    std::string line;
+    if(!writeAll(fd, cmd.data(), cmd.size()))
+        return line;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    char c;
+    while(poll(&pfd, 1, PLAY_TIMEOUT_MS) > 0 && read(fd, &c, 1) == 1){
+        if(c == '\n')
+            break;
+        if(c != '\r')
+            line += c;
+    }
+    return line;
+}
+
+// Read the codes played and the underruns of the board
+static bool boardStats(int fd, unsigned long &played, unsigned long &underrun)
+{
+    std::string ans = command(fd, "stats\n");
+    const char *s = strstr(ans.c_str(), "played");
+    const char *u = strstr(ans.c_str(), "underrun");
+    return s && u && sscanf(s, "played %lu", &played) == 1 && sscanf(u, "underrun %lu", &underrun) == 1;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options] input.wav|input.csv\n"
+        "  -d, --device PATH    testDAC port (/dev/ttyACM0); a file or pipe gets the codes only\n"
+        "  -r, --rate HZ        output rate (default: the rate of the input, max %d)\n"
+        "  -a, --amp MV         WAV full scale amplitude (default 1000)\n"
+        "  -o, --offset MV      WAV offset (default 500)\n"
+        "  -c, --channel N      WAV channel (default 0)\n"
+        "  -i, --in-rate HZ     CSV sample rate (required for CSV)\n"
+        "  -k, --column N       CSV column (default 0)\n"
+        "  -R, --range MV       range of the output stage (default %d)\n",
+        name, PLAY_MAX_RATE, DAC_RANGE);
+}
+
+int main(int argc, char **argv)
+{
+    const char *device = "/dev/ttyACM0";
+    double rate = 0, in_rate = 0, amp = 1000, offset = 500;
+    unsigned channel = 0, column = 0;
+    uint16_t range = DAC_RANGE;
+
+    static const struct option opts[] = {
+        {"device", required_argument, nullptr, 'd'}, {"rate", required_argument, nullptr, 'r'},
+        {"amp", required_argument, nullptr, 'a'}, {"offset", required_argument, nullptr, 'o'},
+        {"channel", required_argument, nullptr, 'c'}, {"in-rate", required_argument, nullptr, 'i'},
+        {"column", required_argument, nullptr, 'k'}, {"range", required_argument, nullptr, 'R'},
+        {nullptr, 0, nullptr, 0}};
+    int opt;
+    while((opt = getopt_long(argc, argv, "d:r:a:o:c:i:k:R:", opts, nullptr)) != -1){
+        switch(opt){
+            case 'd': device = optarg; break;
+            case 'r': rate = atof(optarg); break;
+            case 'a': amp = atof(optarg); break;
+            case 'o': offset = atof(optarg); break;
+            case 'c': channel = atoi(optarg); break;
+            case 'i': in_rate = atof(optarg); break;
+            case 'k': column = atoi(optarg); break;
+            case 'R': range = atoi(optarg); break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if(optind != argc - 1){
+        usage(argv[0]);
+        return 2;
+    }
+
+    const char *path = argv[optind];
+    MappedFile file;
+    if(!file.open(path)){
+        fprintf(stderr, "%s: cannot map the file\n", path);
+        return 1;
+    }
+    std::unique_ptr<Source> src;
+    size_t len = strlen(path);
+    if(len > 4 && !strcasecmp(path + len - 4, ".csv")){
+        if(in_rate <= 0){
+            fprintf(stderr, "%s: --in-rate is required for CSV\n", path);
+            return 2;
+        }
+        auto csv = std::make_unique<CsvSource>();
+        csv->open(file, column, in_rate);
+        src = std::move(csv);
+    }
+    else{
+        auto wav = std::make_unique<WavSource>();
+        std::string err;
+        if(!wav->open(file, channel, amp, offset, err)){
+            fprintf(stderr, "%s: %s\n", path, err.c_str());
+            return 1;
+        }
+        src = std::move(wav);
+    }
+    if(rate <= 0)
+        rate = src->rate;
+    if(rate > PLAY_MAX_RATE)
+        rate = PLAY_MAX_RATE;
+
+    struct stat st;
+    bool chr = stat(device, &st) == 0 && S_ISCHR(st.st_mode);
+    int fd = chr ? open(device, O_RDWR | O_NOCTTY) : open(device, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0){
+        fprintf(stderr, "%s: %s\n", device, strerror(errno));
+        return 1;
+    }
+    bool board = isatty(fd);
+    if(board){
+        tcflush(fd, TCIOFLUSH);
+        if(!setRaw(fd)){
+            fprintf(stderr, "%s: cannot set raw mode\n", device);
+            return 1;
+        }
+        std::string ans = command(fd, "rate " + std::to_string((unsigned long)lround(rate)) + "\n");
+        unsigned long got;
+        if(sscanf(ans.c_str(), "ok rate %lu", &got) != 1){
+            fprintf(stderr, "%s: no answer to rate (%s)\n", device, ans.c_str());
+            return 1;
+        }
+        rate = got; // The codes are resampled to the rate of the board
+    }
+
+    Converter conv(*src, rate, range);
+    fprintf(stderr, "%s: %llu samples at %.0f Hz -> %llu codes at %.0f Hz (%.1f s)\n", path,
+        (unsigned long long)src->frames, src->rate, (unsigned long long)conv.total, rate,
+        conv.total/rate);
+    // Stream: the writes block while the ring of the board is full. One play command per second
+    // of codes, the board only reads commands between them.
+    std::vector<uint8_t> buf(PLAY_CHUNK);
+    auto t0 = Clock::now();
+    auto tprint = t0;
+    uint64_t sent = 0, last = 0;
+    unsigned long played = 0, underrun = 0;
+    while(sent < conv.total){
+        uint64_t seg = board ? std::min<uint64_t>((uint64_t)rate, conv.total - sent) : conv.total;
+        if(board){
+            if(sent && !boardStats(fd, played, underrun)){
+                fprintf(stderr, "\n%s: no answer to stats\n", device);
+                return 1;
+            }
+            std::string ans = command(fd, "play " + std::to_string((unsigned long long)seg) + "\n");
+            if(ans.rfind("ok play", 0) != 0){
+                fprintf(stderr, "\n%s: no answer to play (%s)\n", device, ans.c_str());
+                return 1;
+            }
+        }
+        for(uint64_t end = sent + seg; sent < end;){
+            size_t n = std::min<uint64_t>(buf.size(), end - sent);
+            for(size_t i = 0; i < n; i++)
+                buf[i] = conv.next();
+            if(!writeAll(fd, buf.data(), n)){
+                fprintf(stderr, "\n%s: %s\n", device, strerror(errno));
+                return 1;
+            }
+            sent += n;
+            auto now = Clock::now();
+            double dt = std::chrono::duration<double>(now - tprint).count();
+            if(dt >= 1.0){
+                fprintf(stderr, "\r%5.1f%%  %8.1f kB/s (%5.1f%% of the rate)", 100.0*sent/conv.total,
+                    (sent - last)/dt/1000, 100.0*(sent - last)/dt/rate);
+                if(board)
+                    fprintf(stderr, "  %lu underruns", underrun);
+                last = sent;
+                tprint = now;
+            }
+        }
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    fprintf(stderr, "\r%llu codes in %.2f s: %.1f kB/s sustained, %llu clipped\n",
+        (unsigned long long)sent, elapsed, elapsed > 0 ? sent/elapsed/1000 : 0.0,
+        (unsigned long long)conv.clipped);
+
+    if(board){
+        // The last codes are still in the ring of the board
+        usleep((useconds_t)(1e6*PLAY_RING/rate) + 200000);
+        if(boardStats(fd, played, underrun))
+            fprintf(stderr, "board: %lu played, %lu underruns\n", played, underrun);
+        else
+            fprintf(stderr, "board: no answer to stats\n");
+    }
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,593 @@
+/**
+ * \file        dsg_render.cpp
+ * \brief       Offline renderer of a signal configuration of irq_c to WAV/CSV.
+ * \details     The tables are built as updateSignal() of irq_c does: signal_calculate() or the
+ * interpolated wavetable (wt_ref_build(), wt_ref_next()), with the duty cycles, converted by
+ * dac_codes() of dsg_core with the requantization and the calibration table fitted from the
+ * measured points of a file (dac_cal_fit()). The noise waveforms come from the buffers of
+ * dsg_noise_buf.h, and the channel B follows the frequency and the playback mode of the channel A
+ * plus its phase. Each sample is written with dac_output_codes() to the dac_parallel8 backend
+ * against the mock HAL, and the codes of both channels are read back from the GPIOs.
+ *
+ * One code each t_sample us, the sample time of the signal ISR (clamped to the max rate of the
+ * backend, as updateSignal()), or each WT_T_SAMPLE us in the interpolated mode. When the output
+ * repeats with the table (table mode without noise nor TPDF), one period is rendered and the
+ * file is written with large blocks of whole periods: hours of output take the time of the
+ * disk. Otherwise the samples are generated one by one.
+ *
+ * Not reproduced: the main loop of the firmware runs when it can, here the TPDF dither is drawn
+ * again exactly at the start of each period and the noise buffers never underrun; the seed of
+ * the white noise is NG_SEED instead of the time of the boot; the sync output, the DMA backends
+ * and the closed loop correction are not rendered.
+ *
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <charconv>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <strings.h>
+#include <unistd.h>
+
+extern "C" {
+#include "dsg_hal.h"
+#include "hal_mock.h"
+#include "dsg_signal.h"
+#include "dsg_dac.h"
+#include "dsg_dac_cal.h"
+#include "dsg_noise_buf.h"
+#include "wavetable_ref.h"
+}
+
+#define RENDER_LSB      10              // GPIO of the DAC LSB, as in the variants
+#define RENDER_BLOCK    (1u << 20)      // Bytes per write
+#define RENDER_WAV_MAX  0xFFFFFFFFull   // Size field of a RIFF chunk
+
+using Clock = std::chrono::steady_clock;
+
+static const char *gShape[SIGNAL_STATES] = {"sin", "tri", "saw", "sqr", "white", "pink", "prbs"};
+static const char *gRequant[] = {"nearest", "tpdf", "shape"};
+static const uint8_t gPinsB[8] = {19, 20, 21, 22, 26, 27, 28, 1}; // Channel B of irq_c, LSB first
+
+/**
+ * @brief A sample of the output: the codes read back from the GPIOs and the values before the
+ * quantization (for the noise, the value of the code).
+ */
+struct Frame {
+    uint8_t code[2];
+    float mv[2];
+};
+
+/**
+ * @brief The generator of irq_c with its tables, one sample per call as timerSignalCallback().
+ */
+struct Engine {
+    signal_t a, b;
+    dac_t dac;
+    noise_t noise;
+    bool twoChannels;
+    uint32_t qa[SAMPLE], qb[SAMPLE];                // Codes without the dither of the tables
+    uint16_t wta[WT_SIZE + 1], wtb[WT_SIZE + 1];    // Wavetables, with the guard entry
+    uint32_t wqa[WT_SIZE], wqb[WT_SIZE];
+    int16_t wva[WT_SIZE + 1], wvb[WT_SIZE + 1];     // Values of the wavetables, for the CSV
+    uint32_t pha = 0, phb = 0, step = 0;
+    uint32_t tick;                                  // Time between samples, in us
+    uint32_t clipped = 0;                           // Values of the tables out of the range of the DAC
+
+    bool noiseA() { return signal_is_noise(&a); }
+
+    /**
+     * @brief Values out of the output range of the transfer, saturated to the first or last code
+     */
+    void countClipped(const int16_t *v, size_t n)
+    {
+        double half = (dac_mv(&dac, dac_code_max(&dac)) - dac_mv(&dac, 0))/(2.0*dac_code_max(&dac));
+        for(size_t i = 0; i < n; i++)
+            if(v[i] < dac_mv(&dac, 0) - half || v[i] > dac_mv(&dac, dac_code_max(&dac)) + half)
+                clipped++;
+    }
+
+    /**
+     * @brief Build the tables and lock the channel B, as updateSignal() and startSignal()
+     */
+    void start()
+    {
+        signal_set_freq(&b, a.freq);
+        b.STATE.interp = a.STATE.interp;
+        uint32_t t_min = (S_TO_US + dac.backend->max_rate(&dac) - 1)/dac.backend->max_rate(&dac);
+        if(a.t_sample < t_min){
+            a.t_sample = t_min;
+            b.t_sample = t_min;
+        }
+        tick = a.STATE.interp ? WT_T_SAMPLE : a.t_sample;
+
+        if(!noiseA()){
+            signal_calculate(&a);
+            dac_codes(&dac, a.arrayV, a.arrayC, qa, SAMPLE);
+            countClipped(a.arrayV, SAMPLE);
+        }
+        if(twoChannels){
+            signal_calculate(&b);
+            dac_codes(&dac, b.arrayV, b.arrayC, qb, SAMPLE);
+            countClipped(b.arrayV, SAMPLE);
+        }
+        if(a.STATE.interp){
+            if(!noiseA()){
+                wt_ref_build(wta, wqa, &a, &dac);
+                signal_values(&a, wva, WT_SIZE);
+                wva[WT_SIZE] = wva[0];
+            }
+            if(twoChannels){
+                wt_ref_build(wtb, wqb, &b, &dac);
+                signal_values(&b, wvb, WT_SIZE);
+                wvb[WT_SIZE] = wvb[0];
+            }
+        }
+        if(noiseA())
+            noise_restart(&noise, &a, &dac);
+
+        step = wt_ref_step(a.freq);
+        a.cnt = 0;
+        b.cnt = (uint32_t)b.phase*SAMPLE/360;
+        pha = 0;
+        phb = pha + (uint32_t)(((uint64_t)b.phase << 32)/360);
+    }
+
+    /**
+     * @brief The output repeats with the table of SAMPLE points
+     */
+    bool periodic()
+    {
+        return !a.STATE.interp && !noiseA() && dac.requant != DAC_REQ_TPDF;
+    }
+
+    /**
+     * @brief Value of a wavetable at a phase, the blend of wt_ref_next() on the values in mV
+     */
+    static float blend(const int16_t *v, uint32_t phase)
+    {
+        uint32_t idx = phase >> (32 - WT_BITS);
+        float alpha = (float)((phase >> WT_FRAC_SHIFT) & 0xFF)/256;
+        return v[idx] + (v[idx + 1] - v[idx])*alpha;
+    }
+
+    /**
+     * @brief Next sample. The TPDF dither is drawn again at the start of each period, the noise
+     * buffer is filled as soon as it is consumed.
+     */
+    Frame next()
+    {
+        Frame f;
+        uint16_t code_a, code_b = 0;
+        if(a.STATE.interp){
+            bool start = pha < step;
+            if(start && dac.requant == DAC_REQ_TPDF){
+                if(!noiseA()){
+                    dac_redither(&dac, wqa, wta, WT_SIZE);
+                    wta[WT_SIZE] = wta[0];
+                }
+                dac_redither(&dac, wqb, wtb, WT_SIZE);
+                wtb[WT_SIZE] = wtb[0];
+            }
+            f.mv[0] = noiseA() ? 0 : blend(wva, pha);
+            f.mv[1] = twoChannels ? blend(wvb, phb) : 0;
+            code_a = wt_ref_next(wta, &pha, step);
+            code_b = twoChannels ? wt_ref_next(wtb, &phb, step) : 0;
+        }
+        else{
+            if(!a.cnt && dac.requant == DAC_REQ_TPDF){
+                if(!noiseA())
+                    dac_redither(&dac, qa, a.arrayC, SAMPLE);
+                if(twoChannels)
+                    dac_redither(&dac, qb, b.arrayC, SAMPLE);
+            }
+            f.mv[0] = a.arrayV[a.cnt];
+            f.mv[1] = b.arrayV[b.cnt];
+            code_a = a.arrayC[a.cnt];
+            code_b = twoChannels ? b.arrayC[b.cnt] : 0;
+            a.cnt = (a.cnt + 1)%SAMPLE;
+            b.cnt = (b.cnt + 1)%SAMPLE;
+        }
+        if(noiseA()){
+            code_a = noise_next(&noise);
+            noise_fill(&noise, &a, &dac);
+        }
+        dac_output_codes(&dac, code_a, code_b);
+
+        // The codes on the GPIOs of both buses
+        uint32_t out = hal_mock_outputs();
+        f.code[0] = (out >> RENDER_LSB) & 0xFF;
+        f.code[1] = 0;
+        for(uint8_t i = 0; twoChannels && i < 8; i++)
+            f.code[1] |= ((out >> gPinsB[i]) & 1) << i;
+        if(noiseA())
+            f.mv[0] = dac_mv(&dac, f.code[0]);
+        return f;
+    }
+};
+
+static bool writeAll(int fd, const void *data, size_t n)
+{
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    while(n){
+        ssize_t w = write(fd, p, n);
+        if(w < 0){
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        p += w;
+        n -= w;
+    }
+    return true;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = v; p[1] = v >> 8;
+}
+
+/**
+ * @brief Write n bytes of a periodic sequence, starting at its phase 0.
+ *
+ * @param fd
+ * @param period    One period
+ * @param len       Length of the period
+ * @param n         Bytes to write
+ */
+static bool writePeriodic(int fd, const uint8_t *period, size_t len, uint64_t n)
+{
+    // A block of whole periods keeps the phase between writes
+    size_t reps = RENDER_BLOCK/len ? RENDER_BLOCK/len : 1;
+    std::vector<uint8_t> block(reps*len);
+    for(size_t i = 0; i < reps; i++)
+        memcpy(&block[i*len], period, len);
+    while(n){
+        size_t k = n < block.size() ? n : block.size();
+        if(!writeAll(fd, block.data(), k))
+            return false;
+        n -= k;
+    }
+    return true;
+}
+
+/**
+ * @brief Output of the samples to a file, in blocks
+ */
+struct Writer {
+    int fd;
+    bool csv;
+    bool us;                    // WAV: one frame per us, each code held tick us
+    unsigned channels;
+    uint32_t tick;
+    const dac_t *dac;
+    uint64_t i = 0;             // Samples written
+    std::vector<char> buf;
+
+    Writer(int f, bool c, bool u, unsigned ch, uint32_t t, const dac_t *d) :
+        fd(f), csv(c), us(u), channels(ch), tick(t), dac(d) { buf.reserve(RENDER_BLOCK + 256); }
+
+    bool flush(bool force)
+    {
+        if(buf.size() < RENDER_BLOCK && !force)
+            return true;
+        bool ok = writeAll(fd, buf.data(), buf.size());
+        buf.clear();
+        return ok;
+    }
+
+    /**
+     * @brief WAV header: 8-bit unsigned PCM, the channel A and, if it is used, the channel B
+     */
+    bool header(uint64_t updates)
+    {
+        if(csv){
+            static const char head1[] = "t_us,mv,code,mv_out\n";
+            static const char head2[] = "t_us,mv,code,mv_out,mv_b,code_b,mv_out_b\n";
+            const char *h = channels == 2 ? head2 : head1;
+            buf.insert(buf.end(), h, h + strlen(h));
+            return true;
+        }
+        uint64_t frames = us ? (updates + 1)*tick : updates;
+        uint32_t rate = us ? S_TO_US : (uint32_t)lround((double)S_TO_US/tick);
+        if(frames*channels + 36 > RENDER_WAV_MAX){
+            fprintf(stderr, "wav: %llu frames do not fit in a RIFF file\n", (unsigned long long)frames);
+            return false;
+        }
+
+        uint8_t h[44];
+        memcpy(h, "RIFF", 4);
+        put32(h + 4, (uint32_t)(36 + frames*channels));
+        memcpy(h + 8, "WAVEfmt ", 8);
+        put32(h + 16, 16);
+        put16(h + 20, 1);                   // PCM
+        put16(h + 22, channels);
+        put32(h + 24, rate);
+        put32(h + 28, rate*channels);       // Bytes per second
+        put16(h + 32, channels);            // Bytes per frame
+        put16(h + 34, 8);
+        memcpy(h + 36, "data", 4);
+        put32(h + 40, (uint32_t)(frames*channels));
+        buf.insert(buf.end(), h, h + sizeof(h));
+
+        // The GPIOs are low until the first event
+        if(us)
+            buf.insert(buf.end(), (size_t)tick*channels, 0);
+        return true;
+    }
+
+    bool put(const Frame &f)
+    {
+        i++;
+        if(csv){
+            char s[128];
+            char *e = std::to_chars(s, s + 24, i*tick).ptr;
+            e += snprintf(e, 48, ",%.1f,%u,%d", f.mv[0], f.code[0], dac_mv(dac, f.code[0]));
+            if(channels == 2)
+                e += snprintf(e, 48, ",%.1f,%u,%d", f.mv[1], f.code[1], dac_mv(dac, f.code[1]));
+            *e++ = '\n';
+            buf.insert(buf.end(), s, e);
+        }
+        else{
+            for(uint32_t k = 0; k < (us ? tick : 1); k++)
+                buf.insert(buf.end(), f.code, f.code + channels);
+        }
+        return flush(false);
+    }
+};
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options] [output.wav|output.csv]\n"
+        "  -w, --shape S        sin, tri, saw, sqr, white, pink or prbs (default sin)\n"
+        "  -f, --freq HZ        frequency (default 1000)\n"
+        "  -a, --amp MV         amplitude (default 1000)\n"
+        "  -o, --offset MV      offset (default 500)\n"
+        "  -d, --duty D         symmetry or duty cycle in tenths of percent (default 500, saw 1000)\n"
+        "  -p, --prbs N         order of the PRBS: 7, 15 or 23 (default 7)\n"
+        "  -i, --interp         interpolated wavetable at %d Hz instead of the %d points table\n"
+        "  -q, --requant MODE   nearest, tpdf or shape (default nearest)\n"
+        "  -C, --cal FILE       calibration: lines 'code,mV' measured as cal_code/cal_mv\n"
+        "  -b, --b-shape S      channel B: sin, tri, saw or sqr (default: only the channel A)\n"
+        "  -A, --b-amp MV       channel B amplitude (default 1000)\n"
+        "  -O, --b-offset MV    channel B offset (default 500)\n"
+        "  -D, --b-duty D       channel B symmetry or duty cycle\n"
+        "  -P, --phase DEG      channel B phase (default 90)\n"
+        "  -R, --range MV       range of the output stage (default %d)\n"
+        "  -s, --seconds S      length (default 1)\n"
+        "  -u, --us             WAV with one frame per us (1 MHz), each code held t_sample us\n"
+        "A WAV has the channel A, and the channel B as the second channel when it is used.\n"
+        "Without an output file, only the summary is printed.\n",
+        name, WT_FS, SAMPLE, DAC_RANGE);
+}
+
+/**
+ * @brief Index of a name in a list, n if it is not there
+ */
+static unsigned lookup(const char *s, const char *const *names, unsigned n)
+{
+    unsigned k = 0;
+    while(k < n && strcmp(s, names[k]))
+        k++;
+    return k;
+}
+
+/**
+ * @brief Fit the calibration table of the DAC to the points of a file, as cal_save
+ */
+static bool loadCal(const char *path, dac_t *dac)
+{
+    FILE *f = fopen(path, "r");
+    if(!f){
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    dac_cal_t cal;
+    dac_cal_init(&cal);
+    char line[128];
+    bool ok = true;
+    while(ok && fgets(line, sizeof(line), f)){
+        unsigned code;
+        int mv;
+        if(sscanf(line, " %u %*[,;\t ] %d", &code, &mv) == 2 || sscanf(line, " %u %d", &code, &mv) == 2)
+            ok = code <= dac_code_max(dac) && mv >= INT16_MIN && mv <= INT16_MAX && dac_cal_add(&cal, code, mv);
+    }
+    fclose(f);
+    if(!ok || !dac_cal_fit(&cal, dac)){
+        fprintf(stderr, "%s: at least two points with the output increasing with the code\n", path);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned shape = 0, shapeB = SIGNAL_STATES, prbs = 7, requant = DAC_REQ_NEAREST;
+    unsigned long freq = 1000;
+    long amp = 1000, offset = 500, ampB = 1000, offsetB = 500, duty = -1, dutyB = -1, phase = 90;
+    long range = DAC_RANGE;
+    double seconds = 1;
+    bool us = false, interp = false;
+    const char *calPath = nullptr;
+
+    static const struct option opts[] = {
+        {"shape", required_argument, nullptr, 'w'}, {"freq", required_argument, nullptr, 'f'},
+        {"amp", required_argument, nullptr, 'a'}, {"offset", required_argument, nullptr, 'o'},
+        {"duty", required_argument, nullptr, 'd'}, {"prbs", required_argument, nullptr, 'p'},
+        {"interp", no_argument, nullptr, 'i'}, {"requant", required_argument, nullptr, 'q'},
+        {"cal", required_argument, nullptr, 'C'}, {"b-shape", required_argument, nullptr, 'b'},
+        {"b-amp", required_argument, nullptr, 'A'}, {"b-offset", required_argument, nullptr, 'O'},
+        {"b-duty", required_argument, nullptr, 'D'}, {"phase", required_argument, nullptr, 'P'},
+        {"range", required_argument, nullptr, 'R'}, {"seconds", required_argument, nullptr, 's'},
+        {"us", no_argument, nullptr, 'u'}, {nullptr, 0, nullptr, 0}};
+    int opt;
+    bool ok = true;
+    while(ok && (opt = getopt_long(argc, argv, "w:f:a:o:d:p:iq:C:b:A:O:D:P:R:s:u", opts, nullptr)) != -1){
+        switch(opt){
+            case 'w': ok = (shape = lookup(optarg, gShape, SIGNAL_STATES)) < SIGNAL_STATES; break;
+            case 'f': freq = strtoul(optarg, nullptr, 10); break;
+            case 'a': amp = atol(optarg); break;
+            case 'o': offset = atol(optarg); break;
+            case 'd': duty = atol(optarg); break;
+            case 'p': prbs = atoi(optarg); break;
+            case 'i': interp = true; break;
+            case 'q': ok = (requant = lookup(optarg, gRequant, 3)) < 3; break;
+            case 'C': calPath = optarg; break;
+            case 'b': ok = (shapeB = lookup(optarg, gShape, SIGNAL_PERIODIC)) < SIGNAL_PERIODIC; break;
+            case 'A': ampB = atol(optarg); break;
+            case 'O': offsetB = atol(optarg); break;
+            case 'D': dutyB = atol(optarg); break;
+            case 'P': phase = atol(optarg); break;
+            case 'R': range = atol(optarg); break;
+            case 's': seconds = atof(optarg); break;
+            case 'u': us = true; break;
+            default: ok = false; break;
+        }
+    }
+    if(!ok || optind < argc - 1 || !freq || amp < 0 || amp > 0xFFFF || offset < 0 || offset > 0xFFFF ||
+        ampB < 0 || ampB > 0xFFFF || offsetB < 0 || offsetB > 0xFFFF || duty > 1000 || dutyB > 1000 ||
+        phase < 0 || (prbs != 7 && prbs != 15 && prbs != 23) || range < 1 || range > 0xFFFF ||
+        !(seconds > 0)){
+        usage(argv[0]);
+        return 2;
+    }
+    if(interp && freq >= WT_FS/2){
+        fprintf(stderr, "the interpolated mode is limited to %d Hz\n", WT_FS/2 - 1);
+        return 1;
+    }
+
+    // The configuration as the firmware holds it
+    static Engine e;
+    e.twoChannels = shapeB < SIGNAL_PERIODIC;
+    signal_gen_init(&e.a, freq, amp, offset, true);
+    signal_set_state(&e.a, shape);
+    if(duty >= 0)
+        signal_set_duty(&e.a, duty);
+    e.a.STATE.interp = interp;
+    signal_gen_init(&e.b, freq, ampB, offsetB, e.twoChannels);
+    signal_set_state(&e.b, e.twoChannels ? shapeB : 0);
+    if(dutyB >= 0)
+        signal_set_duty(&e.b, dutyB);
+    signal_set_phase(&e.b, phase);
+    dac_init(&e.dac, &dac_parallel8, RENDER_LSB, e.twoChannels ? gPinsB : nullptr, true);
+    dac_set_range(&e.dac, range);
+    if(calPath && !loadCal(calPath, &e.dac))
+        return 1;
+    e.dac.requant = requant;
+    noise_init(&e.noise, 0, prbs);
+
+    auto t0 = Clock::now();
+    e.start();
+
+    // Events of the signal ISR within the length: at tick, 2*tick...
+    uint64_t updates = (uint64_t)(seconds*S_TO_US)/e.tick;
+    unsigned channels = e.twoChannels ? 2 : 1;
+    uint64_t sum = 0;
+    uint8_t lo = 0xFF, hi = 0, loB = 0xFF, hiB = 0;
+    auto stats = [&](const Frame &f, uint64_t times){
+        sum += f.code[0]*times;
+        lo = std::min(lo, f.code[0]);
+        hi = std::max(hi, f.code[0]);
+        loB = std::min(loB, f.code[1]);
+        hiB = std::max(hiB, f.code[1]);
+    };
+
+    int fd = -1;
+    const char *path = optind == argc - 1 ? argv[optind] : nullptr;
+    bool csv = false;
+    if(path){
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0){
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            return 1;
+        }
+        size_t len = strlen(path);
+        csv = len > 4 && !strcasecmp(path + len - 4, ".csv");
+    }
+    Writer w(fd, csv, us, channels, e.tick, &e.dac);
+    errno = 0;
+    if(fd >= 0)
+        ok = w.header(updates);
+
+    if(e.periodic() && !csv){
+        // One period of SAMPLE codes, written in blocks of whole periods
+        std::vector<Frame> p(SAMPLE);
+        for(auto &f : p)
+            f = e.next();
+        uint64_t full = updates/SAMPLE;
+        size_t rem = updates % SAMPLE;
+        for(size_t k = 0; k < SAMPLE; k++)
+            if(full || k < rem)
+                stats(p[k], full + (k < rem));
+        if(fd >= 0 && ok){
+            size_t hold = us ? e.tick : 1;
+            std::vector<uint8_t> period((size_t)SAMPLE*hold*channels);
+            for(size_t k = 0; k < SAMPLE; k++)
+                for(size_t h = 0; h < hold; h++)
+                    memcpy(&period[(k*hold + h)*channels], p[k].code, channels);
+            ok = w.flush(true) && writePeriodic(fd, period.data(), period.size(), updates*hold*channels);
+        }
+    }
+    else{
+        for(uint64_t i = 0; i < updates && ok; i++){
+            Frame f = e.next();
+            stats(f, 1);
+            if(fd >= 0)
+                ok = w.put(f);
+        }
+        if(fd >= 0 && ok)
+            ok = w.flush(true);
+    }
+    if(fd >= 0){
+        if(!ok)
+            fprintf(stderr, "%s: %s\n", path, errno ? strerror(errno) : "not written");
+        close(fd);
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    double dc = updates ? (double)sum/updates : 0;
+    double achieved = interp ? (double)e.step*WT_FS/4294967296.0 : (double)S_TO_US/((double)SAMPLE*e.a.t_sample);
+
+    // One "name value" per line, for the scripts of the sweeps
+    printf("shape %s\n", gShape[shape]);
+    printf("mode %s\n", interp ? "interp" : "table");
+    printf("requant %s\n", gRequant[requant]);
+    printf("calibrated %s\n", calPath ? "yes" : "no");
+    printf("freq_set %lu\n", freq);
+    printf("t_sample_us %u\n", e.tick);
+    printf("freq %.3f\n", achieved);
+    printf("freq_error_pct %+.3f\n", 100*(achieved - freq)/freq);
+    printf("samples %llu\n", (unsigned long long)updates);
+    printf("seconds %.6f\n", (double)updates*e.tick/S_TO_US);
+    printf("code_min %u\ncode_max %u\n", lo, hi);
+    printf("mv_min %d\nmv_max %d\n", dac_mv(&e.dac, lo), dac_mv(&e.dac, hi));
+    printf("dc_code %.3f\ndc_mv %.1f\n", dc, dac_mv(&e.dac, (uint16_t)dc) +
+        (dac_mv(&e.dac, (uint16_t)dc + 1) - dac_mv(&e.dac, (uint16_t)dc))*(dc - floor(dc)));
+    if(e.twoChannels){
+        printf("shape_b %s\nphase_b %u\n", gShape[shapeB], e.b.phase);
+        printf("code_b_min %u\ncode_b_max %u\n", loB, hiB);
+    }
+    printf("clipped %u\n", e.clipped);
+    fprintf(stderr, "rendered in %.3f s\n", elapsed);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,666 @@
+/**
+ * \file        dsg_spectrum.cpp
+ * \brief       Spectral quality of code streams: THD, SFDR, SNR/SINAD, ENOB and frequency error.
+ * \details     A stream is a WAV file (dsg_render, a capture) or raw 8-bit codes (dsg_play to a
+ * file). Its power spectrum is the average of Blackman-Harris windowed FFTs of half-overlapped
+ * segments (Welch), computed by several threads on large captures.
+ *
+ * The sweep mode renders the configurations itself: every waveform, frequency and table size,
+ * in the table mode of the variants (one code each truncated t_sample us) and in the
+ * interpolated mode of irq_c (wavetable_ref.h, WT_FS). The tables are the ones of dsg_core
+ * (signal_values(), the default duty cycles) and all the values are converted by dac_code()
+ * with the nominal transfer. With --requant they are converted with the requantization of
+ * irq_c instead (requant_ref.h on dac_code_q()): nearest, TPDF dither drawn again every period
+ * as the main loop does, or error feedback. The configurations are analyzed in parallel.
+ *
+ * \author      MST_CDA
+ * \version     0.0.1
+ * \date        18/10/2026
+ * \copyright   Unlicensed
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern "C" {
+#include "dsg_hal.h"
+#include "dsg_signal.h"
+#include "dsg_dac.h"
+#include "wavetable_ref.h"
+#include "requant_ref.h"
+}
+
+#define SPEC_NFFT       65536           // Default length of the FFT
+#define SPEC_MAX_NFFT   (1u << 24)
+#define SPEC_PERIODS    16              // Least periods of the fundamental per FFT
+#define SPEC_LOBE       6               // Half width in bins of a tone (main lobe of the window)
+#define SPEC_HARM       10              // Harmonics of THD: 2 to SPEC_HARM
+#define SPEC_SEARCH     0.05            // The fundamental is searched within 5% of the expected one
+#define SPEC_INF        200             // dB, above it a ratio is printed as inf
+#define SPEC_SEED       0x2545F491      // Seed of the dither, the same every run
+
+using cplx = std::complex<double>;
+
+static const char *gShape[] = {"sin", "tri", "saw", "sqr"};
+static const char *gRequant[] = {"nearest", "tpdf", "shape"};
+
+// ------------------------------------------------------------------
+// ------------------------------ FFT -------------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Power spectrum of real segments of n points: radix-2 FFT of n/2 complex points, the
+ * even samples as the real part and the odd ones as the imaginary part.
+ */
+struct Fft {
+    size_t n = 0;
+    std::vector<cplx> tw;           // e^(-2*pi*i*k/n), k < n/2
+    std::vector<uint32_t> rev;      // Bit reversal of n/2
+    std::vector<double> win;
+
+    explicit Fft(size_t len) : n(len), tw(len/2), rev(len/2), win(len)
+    {
+        size_t h = n/2;
+        unsigned bits = 0;
+        while((1u << bits) < h)
+            bits++;
+        for(size_t k = 0; k < h; k++){
+            tw[k] = std::polar(1.0, -2*M_PI*k/n);
+            uint32_t r = 0;
+            for(unsigned b = 0; b < bits; b++)
+                r |= ((k >> b) & 1u) << (bits - 1 - b);
+            rev[k] = r;
+        }
+        // Blackman-Harris, 4 terms: sidelobes below -92 dB
+        for(size_t i = 0; i < n; i++){
+            double x = 2*M_PI*i/n;
+            win[i] = 0.35875 - 0.48829*cos(x) + 0.14128*cos(2*x) - 0.01168*cos(3*x);
+        }
+    }
+
+    /**
+     * @brief Add the power of the bins 0 to n/2 of x (n points, mean removed) to pw.
+     */
+    void power(const double *x, std::vector<cplx> &z, std::vector<double> &pw) const
+    {
+        size_t h = n/2;
+        double mean = 0;
+        for(size_t i = 0; i < n; i++)
+            mean += x[i];
+        mean /= n;
+        z.resize(h);
+        for(size_t k = 0; k < h; k++)
+            z[rev[k]] = cplx((x[2*k] - mean)*win[2*k], (x[2*k + 1] - mean)*win[2*k + 1]);
+
+        // Iterative radix-2 of h points, twiddles of n points taken with a stride
+        for(size_t len = 2; len <= h; len <<= 1){
+            size_t half = len/2, stride = n/len;
+            for(size_t i = 0; i < h; i += len){
+                for(size_t j = 0; j < half; j++){
+                    cplx t = z[i + j + half]*tw[j*stride];
+                    z[i + j + half] = z[i + j] - t;
+                    z[i + j] += t;
+                }
+            }
+        }
+
+        // Split the transforms of the even and odd samples
+        pw[0] += std::norm(cplx(z[0].real() + z[0].imag(), 0));
+        pw[h] += std::norm(cplx(z[0].real() - z[0].imag(), 0));
+        for(size_t k = 1; k < h; k++){
+            cplx a = z[k], b = std::conj(z[h - k]);
+            cplx even = (a + b)*0.5;
+            cplx odd = (a - b)*cplx(0, -0.5);
+            pw[k] += std::norm(even + tw[k]*odd);
+        }
+    }
+};
+
+// ------------------------------------------------------------------
+// ---------------------------- Metrics -----------------------------
+// ------------------------------------------------------------------
+
+struct Metrics {
+    double freq = 0;        // Measured fundamental in Hz
+    double thd = 0;         // dBc
+    double sfdr = 0;        // dBc
+    double snr = 0;         // dB
+    double sinad = 0;       // dB
+    double enob = 0;        // bits
+};
+
+/**
+ * @brief Metrics of an averaged power spectrum of n/2 + 1 bins.
+ *
+ * @param pw
+ * @param rate      Sample rate in Hz
+ * @param expect    Expected fundamental in Hz, 0 to take the highest peak
+ */
+static Metrics analyze(const std::vector<double> &pw, double rate, double expect)
+{
+    size_t bins = pw.size();
+    double df = rate/(2.0*(bins - 1));
+    std::vector<bool> used(bins, false);
+    auto mark = [&](size_t c){
+        double p = 0;
+        for(size_t k = c > SPEC_LOBE ? c - SPEC_LOBE : 0; k <= c + SPEC_LOBE && k < bins; k++){
+            if(!used[k])
+                p += pw[k];
+            used[k] = true;
+        }
+        return p;
+    };
+
+    // DC, and the window leakage of the mean
+    mark(0);
+
+    // Fundamental: the highest peak, near the expected frequency if it is given
+    size_t lo = SPEC_LOBE + 1, hi = bins - 1;
+    if(expect > 0){
+        double f = fmod(expect, rate);
+        if(f > rate/2)
+            f = rate - f;
+        size_t c = (size_t)lround(f/df);
+        size_t w = std::max<size_t>(2*SPEC_LOBE, lround(SPEC_SEARCH*f/df));
+        lo = std::max(lo, c > w ? c - w : 0);
+        hi = std::min(hi, c + w);
+    }
+    size_t peak = lo;
+    for(size_t k = lo; k <= hi; k++)
+        if(pw[k] > pw[peak])
+            peak = k;
+    double num = 0, den = 0;
+    for(size_t k = peak - std::min<size_t>(peak, SPEC_LOBE); k <= peak + SPEC_LOBE && k < bins; k++){
+        num += k*pw[k];
+        den += pw[k];
+    }
+    Metrics m;
+    m.freq = den > 0 ? num/den*df : 0;
+    double p1 = mark(peak);
+
+    // Harmonics, folded into the first Nyquist zone
+    double ph = 0;
+    for(int h = 2; h <= SPEC_HARM; h++){
+        double f = fmod(h*m.freq, rate);
+        if(f > rate/2)
+            f = rate - f;
+        ph += mark((size_t)lround(f/df));
+    }
+
+    // Noise: the rest; the largest spur is searched in the bins not taken by the fundamental
+    double pn = 0, spur = 0;
+    for(size_t k = 0; k < bins; k++){
+        if(!used[k])
+            pn += pw[k];
+        if(k < peak - std::min<size_t>(peak, SPEC_LOBE) || k > peak + SPEC_LOBE)
+            if(k > SPEC_LOBE)
+                spur = std::max(spur, pw[k]);
+    }
+    const double tiny = 1e-300;
+    m.thd = 10*log10((ph + tiny)/p1);
+    m.sfdr = 10*log10(pw[peak]/(spur + tiny));
+    m.snr = 10*log10(p1/(pn + tiny));
+    m.sinad = 10*log10(p1/(pn + ph + tiny));
+    m.enob = (m.sinad - 1.76)/6.02;
+    return m;
+}
+
+/**
+ * @brief Welch spectrum of x: segments of the FFT length, half overlapped, split between the
+ * threads.
+ */
+static std::vector<double> welch(const std::vector<double> &x, const Fft &fft, unsigned threads)
+{
+    size_t n = fft.n, hop = n/2;
+    size_t segs = x.size() < n ? 0 : (x.size() - n)/hop + 1;
+    std::vector<std::vector<double>> part(threads, std::vector<double>(n/2 + 1, 0.0));
+    std::atomic<size_t> next(0);
+    auto work = [&](unsigned id){
+        std::vector<cplx> z;
+        for(size_t s; (s = next++) < segs;)
+            fft.power(&x[s*hop], z, part[id]);
+    };
+    std::vector<std::thread> pool;
+    for(unsigned t = 1; t < threads; t++)
+        pool.emplace_back(work, t);
+    work(0);
+    for(auto &t : pool)
+        t.join();
+    for(unsigned t = 1; t < threads; t++)
+        for(size_t k = 0; k <= n/2; k++)
+            part[0][k] += part[t][k];
+    return part[0];
+}
+
+// ------------------------------------------------------------------
+// ----------------------------- Input ------------------------------
+// ------------------------------------------------------------------
+
+static uint32_t rd32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+static uint16_t rd16(const uint8_t *p) { return p[0] | p[1] << 8; }
+
+/**
+ * @brief Samples of a WAV (PCM 8/16 bits or float 32, first channel) or of raw 8-bit codes.
+ *
+ * @param path
+ * @param x         Samples
+ * @param rate      Sample rate, set by the WAV
+ * @param err
+ */
+static bool load(const char *path, std::vector<double> &x, double &rate, std::string &err)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) < 0 || st.st_size == 0){
+        err = fd < 0 ? strerror(errno) : "empty file";
+        if(fd >= 0)
+            close(fd);
+        return false;
+    }
+    void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED){
+        err = strerror(errno);
+        return false;
+    }
+    const uint8_t *d = static_cast<const uint8_t *>(map);
+    size_t size = st.st_size;
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    bool ok = true;
+    if(size >= 12 && !memcmp(d, "RIFF", 4) && !memcmp(d + 8, "WAVE", 4)){
+        unsigned fmt = 0, channels = 0, bits = 0;
+        const uint8_t *p = nullptr;
+        size_t len = 0, pos = 12;
+        while(pos + 8 <= size){
+            uint32_t l = rd32(d + pos + 4);
+            const uint8_t *c = d + pos + 8;
+            if(!memcmp(d + pos, "fmt ", 4) && l >= 16){
+                fmt = rd16(c);
+                channels = rd16(c + 2);
+                rate = rd32(c + 4);
+                bits = rd16(c + 14);
+                if(fmt == 0xFFFE && l >= 26)
+                    fmt = rd16(c + 24);
+            }
+            else if(!memcmp(d + pos, "data", 4)){
+                p = c;
+                len = std::min<size_t>(l, size - pos - 8);
+                break;
+            }
+            pos += 8 + l + (l & 1);
+        }
+        unsigned bytes = bits/8;
+        if(!p || !channels || (!(fmt == 1 && (bits == 8 || bits == 16)) && !(fmt == 3 && bits == 32))){
+            err = "only PCM 8/16 bits and float 32 WAV files";
+            ok = false;
+        }
+        else{
+            size_t frames = len/(bytes*channels);
+            x.resize(frames);
+            for(size_t i = 0; i < frames; i++){
+                const uint8_t *s = p + i*bytes*channels;
+                if(bits == 8)
+                    x[i] = s[0];
+                else if(bits == 16)
+                    x[i] = (int16_t)rd16(s);
+                else{
+                    uint32_t u = rd32(s);
+                    float f;
+                    memcpy(&f, &u, 4);
+                    x[i] = f;
+                }
+            }
+        }
+    }
+    else{
+        x.assign(d, d + size); // Raw codes
+    }
+    munmap(map, size);
+    return ok;
+}
+
+// ------------------------------------------------------------------
+// ----------------------------- Sweep ------------------------------
+// ------------------------------------------------------------------
+
+/**
+ * @brief Table of n points in mV: signal_values(), signal_calculate() with SAMPLE = n.
+ */
+static void table(unsigned shape, int32_t amp, int32_t offset, unsigned n, std::vector<int16_t> &v)
+{
+    signal_t signal;
+    signal_gen_init(&signal, 1000, amp, offset, true);
+    signal_set_state(&signal, shape);
+    v.resize(n);
+    signal_values(&signal, v.data(), n);
+}
+
+/**
+ * @brief A configuration of the sweep and its result.
+ */
+struct Config {
+    unsigned shape;
+    uint32_t freq;
+    unsigned n;                 // Points of the table, 0 for the interpolated mode
+    int requant = -1;           // Mode of requant_ref.h, -1 for dac_code()
+    std::vector<uint32_t> q;    // TPDF: codes in 1/RQ_ONE LSB, dithered again every period
+    double rate = 0;            // Rate of the codes
+    std::vector<uint16_t> code; // Table mode: one period; interpolated mode: WT_SIZE + 1 codes
+    bool ok = true;             // The time base can follow
+    Metrics m;
+};
+
+/**
+ * @brief Codes of a table with a mode of requant_ref.h. The error feedback takes the table
+ * as periodic, as dac_codes().
+ */
+static void requant(int mode, const std::vector<uint32_t> &q, std::vector<uint16_t> &code, uint32_t *x)
+{
+    int32_t err = 0;
+    code.resize(q.size());
+    for(int pass = 0; pass < (mode == 2 ? 2 : 1); pass++)
+        for(size_t i = 0; i < q.size(); i++)
+            code[i] = mode == 1 ? rq_ref_tpdf(q[i], RESOLUTION, x) :
+                mode == 2 ? rq_ref_shape(q[i], RESOLUTION, &err) : rq_ref_nearest(q[i], RESOLUTION);
+}
+
+/**
+ * @brief Codes of a configuration, each held x samples. With TPDF the dither is drawn again
+ * at the start of every period.
+ */
+static void render(const Config &c, unsigned x, std::vector<double> &out)
+{
+    std::vector<uint16_t> code = c.code;
+    uint32_t seed = SPEC_SEED;
+    auto redither = [&](){
+        if(c.q.empty())
+            return;
+        for(size_t i = 0; i < c.q.size(); i++)
+            code[i] = rq_ref_tpdf(c.q[i], RESOLUTION, &seed);
+        if(!c.n)
+            code[WT_SIZE] = code[0];
+    };
+    if(c.n){
+        size_t k = 0, h = 0;
+        for(auto &o : out){
+            o = code[k];
+            if(++h == x){
+                h = 0;
+                k = k + 1 == c.n ? 0 : k + 1;
+                if(!k)
+                    redither();
+            }
+        }
+    }
+    else{
+        uint32_t phase = 0, step = wt_ref_step(c.freq);
+        uint16_t v = 0;
+        size_t h = 0;
+        for(auto &o : out){
+            if(!h){
+                v = wt_ref_next(code.data(), &phase, step);
+                if(phase < step)
+                    redither();
+            }
+            o = v;
+            h = h + 1 == x ? 0 : h + 1;
+        }
+    }
+}
+
+/**
+ * @brief Parse a comma separated list of numbers
+ */
+static bool parseList(const char *s, std::vector<uint32_t> &v)
+{
+    v.clear();
+    for(char *e; *s; s = *e ? e + 1 : e){
+        unsigned long u = strtoul(s, &e, 10);
+        if(e == s || (*e && *e != ','))
+            return false;
+        v.push_back(u);
+    }
+    return !v.empty();
+}
+
+/**
+ * @brief A ratio in dB, inf when there is no power in the denominator (coherent periodic codes)
+ */
+static const char *db(char *s, double v)
+{
+    if(fabs(v) > SPEC_INF)
+        strcpy(s, v > 0 ? "inf" : "-inf");
+    else
+        snprintf(s, 16, "%.2f", v);
+    return s;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options] capture.wav|codes.raw\n"
+        "       %s --sweep [options]\n"
+        "  -r, --rate HZ        rate of a raw file\n"
+        "  -f, --freq LIST      expected fundamental; sweep: frequencies (1,10,100,1000,10000)\n"
+        "  -N, --nfft N         FFT length, a power of 2 (default %d)\n"
+        "  -j, --threads N      threads (default: all the cores)\n"
+        "  -S, --sweep          render and analyze every configuration\n"
+        "  -w, --shape LIST     sweep: waveforms (sin,tri,saw,sqr)\n"
+        "  -n, --points LIST    sweep: table sizes, 0 is the interpolated mode (16,%d,0)\n"
+        "  -a, --amp MV         sweep: amplitude (default 1000)\n"
+        "  -o, --offset MV      sweep: offset (default 500)\n"
+        "  -x, --hold N         sweep: samples per code, to see the steps (default 1)\n"
+        "  -q, --requant LIST   sweep: requantization of irq_c instead of dac_code()\n"
+        "                       (nearest,tpdf,shape)\n",
+        name, name, SPEC_NFFT, SAMPLE);
+}
+
+int main(int argc, char **argv)
+{
+    double rate = 0;
+    std::vector<uint32_t> freqs = {1, 10, 100, 1000, 10000};
+    std::vector<uint32_t> points = {16, SAMPLE, 0};
+    std::vector<uint32_t> shapes = {0, 1, 2, 3};
+    std::vector<int> modes = {-1};
+    size_t nfft = SPEC_NFFT;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned hold = 1;
+    long amp = 1000, offset = 500;
+    bool sweep = false;
+    const char *flist = nullptr;
+
+    static const struct option opts[] = {
+        {"rate", required_argument, nullptr, 'r'}, {"freq", required_argument, nullptr, 'f'},
+        {"nfft", required_argument, nullptr, 'N'}, {"threads", required_argument, nullptr, 'j'},
+        {"sweep", no_argument, nullptr, 'S'}, {"shape", required_argument, nullptr, 'w'},
+        {"points", required_argument, nullptr, 'n'}, {"amp", required_argument, nullptr, 'a'},
+        {"offset", required_argument, nullptr, 'o'}, {"hold", required_argument, nullptr, 'x'},
+        {"requant", required_argument, nullptr, 'q'}, {nullptr, 0, nullptr, 0}};
+    int opt;
+    while((opt = getopt_long(argc, argv, "r:f:N:j:Sw:n:a:o:x:q:", opts, nullptr)) != -1){
+        bool ok = true;
+        switch(opt){
+            case 'r': rate = atof(optarg); break;
+            case 'f': flist = optarg; break;
+            case 'N': nfft = strtoul(optarg, nullptr, 10); break;
+            case 'j': threads = std::max(1, atoi(optarg)); break;
+            case 'S': sweep = true; break;
+            case 'w':
+                shapes.clear();
+                for(char *s = optarg, *e; s; s = e ? e + 1 : nullptr){
+                    e = strchr(s, ',');
+                    std::string name(s, e ? (size_t)(e - s) : strlen(s));
+                    unsigned k = 0;
+                    while(k < 4 && name != gShape[k])
+                        k++;
+                    ok = ok && k < 4;
+                    shapes.push_back(k);
+                }
+                break;
+            case 'q':
+                modes.clear();
+                for(char *s = optarg, *e; s; s = e ? e + 1 : nullptr){
+                    e = strchr(s, ',');
+                    std::string name(s, e ? (size_t)(e - s) : strlen(s));
+                    int k = 0;
+                    while(k < 3 && name != gRequant[k])
+                        k++;
+                    ok = ok && k < 3;
+                    modes.push_back(k);
+                }
+                break;
+            case 'n': ok = parseList(optarg, points); break;
+            case 'a': amp = atol(optarg); break;
+            case 'o': offset = atol(optarg); break;
+            case 'x': hold = std::max(1, atoi(optarg)); break;
+            default: ok = false; break;
+        }
+        if(!ok){
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if(nfft < 64 || nfft > SPEC_MAX_NFFT || (nfft & (nfft - 1)) || sweep != (optind == argc) ||
+        (sweep && flist && !parseList(flist, freqs))){
+        usage(argv[0]);
+        return 2;
+    }
+
+    if(!sweep){
+        std::vector<double> x;
+        std::string err;
+        if(!load(argv[optind], x, rate, err)){
+            fprintf(stderr, "%s: %s\n", argv[optind], err.c_str());
+            return 1;
+        }
+        if(rate <= 0){
+            fprintf(stderr, "%s: --rate is required for raw codes\n", argv[optind]);
+            return 2;
+        }
+        while(nfft > 64 && nfft > x.size())
+            nfft /= 2;
+        if(x.size() < nfft){
+            fprintf(stderr, "%s: %zu samples, too short\n", argv[optind], x.size());
+            return 1;
+        }
+        Fft fft(nfft);
+        double expect = flist ? atof(flist) : 0;
+        Metrics m = analyze(welch(x, fft, threads), rate, expect);
+        printf("samples %zu\nrate %.3f\nnfft %zu\n", x.size(), rate, nfft);
+        printf("freq %.4f\n", m.freq);
+        if(expect > 0)
+            printf("freq_error_ppm %+.1f\n", 1e6*(m.freq - expect)/expect);
+        char a[16], b[16], c[16], d[16];
+        printf("thd_db %s\nsfdr_db %s\nsnr_db %s\nsinad_db %s\nenob %.2f\n", db(a, m.thd),
+            db(b, m.sfdr), db(c, m.snr), db(d, m.sinad), m.enob);
+        return 0;
+    }
+
+    // The codes are calculated here, the DAC is not shared by the threads
+    dac_t dac;
+    dac_init(&dac, &dac_parallel8, 10, nullptr, true);
+    std::vector<Config> cfg;
+    for(unsigned s : shapes){
+        for(uint32_t n : points){
+            for(int r : modes){
+                std::vector<int16_t> v;
+                table(s, amp, offset, n ? n : WT_SIZE, v);
+                std::vector<uint16_t> code;
+                std::vector<uint32_t> q;
+                if(r < 0){
+                    for(int16_t mv : v)
+                        code.push_back(dac_code(&dac, mv));
+                }
+                else{
+                    uint32_t seed = SPEC_SEED;
+                    for(int16_t mv : v)
+                        q.push_back(dac_code_q(&dac, mv));
+                    requant(r, q, code, &seed);
+                    if(r != 1)
+                        q.clear();
+                }
+                if(!n)
+                    code.push_back(code[0]); // Guard entry of the interpolation
+                for(uint32_t f : freqs){
+                    Config c;
+                    c.shape = s;
+                    c.freq = f;
+                    c.n = n;
+                    c.requant = r;
+                    c.q = q;
+                    uint32_t t_sample = !f ? 0 : n ? S_TO_US/(n*f) : WT_T_SAMPLE;
+                    c.ok = t_sample && (n || f < WT_FS/2);
+                    c.rate = c.ok ? (double)S_TO_US/t_sample : 0;
+                    c.code = code;
+                    cfg.push_back(std::move(c));
+                }
+            }
+        }
+    }
+
+    // One configuration per thread at a time
+    std::atomic<size_t> next(0);
+    auto work = [&](){
+        std::vector<double> x;
+        for(size_t i; (i = next++) < cfg.size();){
+            Config &c = cfg[i];
+            if(!c.ok)
+                continue;
+            double period = c.rate*hold/c.freq; // Samples per period of the fundamental
+            size_t len = nfft;
+            while(len < SPEC_MAX_NFFT && len < SPEC_PERIODS*period)
+                len *= 2;
+            x.resize(len);
+            render(c, hold, x);
+            Fft fft(len);
+            std::vector<double> pw(len/2 + 1, 0.0);
+            std::vector<cplx> z;
+            fft.power(x.data(), z, pw);
+            // The fundamental obtained is known, the error of the truncation can be above 5%
+            c.m = analyze(pw, c.rate*hold, c.n ? c.rate/c.n : c.freq);
+        }
+    };
+    std::vector<std::thread> pool;
+    for(unsigned t = 0; t < threads; t++)
+        pool.emplace_back(work);
+    for(auto &t : pool)
+        t.join();
+
+    // The mode of the requantization is a column only when it is chosen
+    bool rq = modes[0] >= 0;
+    printf("%-5s %6s %s%9s %12s %12s %10s %8s %8s %8s %8s %6s\n", "shape", "points", rq ? "requant " : "",
+        "freq", "rate", "measured", "err_ppm", "thd", "sfdr", "snr", "sinad", "enob");
+    for(const Config &c : cfg){
+        char pts[16], mode[16] = "";
+        snprintf(pts, sizeof(pts), c.n ? "%u" : "interp", c.n);
+        if(rq)
+            snprintf(mode, sizeof(mode), "%-7s ", gRequant[c.requant]);
+        if(!c.ok){
+            printf("%-5s %6s %s%9u %12s\n", gShape[c.shape], pts, mode, c.freq, "-");
+            continue;
+        }
+        char a[16], b[16], d[16], e[16];
+        printf("%-5s %6s %s%9u %12.3f %12.4f %+10.1f %8s %8s %8s %8s %6.2f\n",
+            gShape[c.shape], pts, mode, c.freq, c.rate, c.m.freq, 1e6*(c.m.freq - c.freq)/c.freq,
+            db(a, c.m.thd), db(b, c.m.sfdr), db(d, c.m.snr), db(e, c.m.sinad), c.m.enob);
+    }
+    return 0;
+}